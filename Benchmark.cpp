@@ -0,0 +1,432 @@
+#include "OrderGateway.cpp"
+#include "RiskGate.cpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+
+// Build: g++ -std=c++20 -O2 -pthread Benchmark.cpp -lbenchmark -o bench
+
+// Per-Iteration Latency Sampler
+// Times only the measured call of each iteration (benchmarks run with UseManualTime), so setup such as
+// refilling the book is excluded from both the throughput and the percentile counters
+class LatencySampler
+{
+public:
+    LatencySampler(benchmark::State& _state)
+    : state(_state)
+    {
+        samples.reserve(1 << 20);
+    }
+
+    ~LatencySampler()
+    {
+        if (samples.empty())
+            return;
+        std::sort(samples.begin(), samples.end());
+        state.counters["p50_ns"] = percentile(0.50);
+        state.counters["p90_ns"] = percentile(0.90);
+        state.counters["p99_ns"] = percentile(0.99);
+        state.counters["p99.9_ns"] = percentile(0.999);
+        state.counters["max_ns"] = double(samples.back());
+        state.SetItemsProcessed(state.iterations() * items_per_iteration);
+    }
+
+    // Time one call and hand its duration to the benchmark
+    template <typename Fn>
+    void measure(Fn&& fn)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        fn();
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+        samples.push_back(ns);
+        state.SetIterationTime(ns * 1e-9);
+    }
+
+    std::int64_t items_per_iteration = 1; // Orders handled per measured call
+
+private:
+    benchmark::State& state;
+    std::vector<std::int64_t> samples;
+
+    double percentile(const double _p) const
+    {
+        return double(samples[std::min(samples.size() - 1, std::size_t(_p * samples.size()))]);
+    }
+};
+
+// Seed a quiet engine with one far-away ask so bids rest without crossing
+static std::shared_ptr<OrderEngine> make_engine()
+{
+    auto engine = std::make_shared<OrderEngine>("BENCH", false);
+    engine->place_order(OrderSide::ASK, OrderType::LIMIT, 1000.0, 1.0);
+    return engine;
+}
+
+// place_order: resting limit orders spread over 100 bid levels
+static void BM_PlaceRestingLimit(benchmark::State& state)
+{
+    auto engine = make_engine();
+    LatencySampler sampler(state);
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        const double price = 10.0 + double(i++ % 100) * 0.01;
+        sampler.measure([&]{ benchmark::DoNotOptimize(engine->place_order(OrderSide::BID, OrderType::LIMIT, price, 1.0)); });
+    }
+}
+BENCHMARK(BM_PlaceRestingLimit)->UseManualTime();
+
+// place_order: aggressive limit/market orders that each fill one resting ask
+static void BM_PlaceCrossing(benchmark::State& state)
+{
+    const OrderType type = state.range(0) ? OrderType::MARKET : OrderType::LIMIT;
+    auto engine = std::make_shared<OrderEngine>("BENCH", false);
+    const std::vector<OrderRequest> refill(10000, OrderRequest{"", OrderSide::ASK, OrderType::LIMIT, 100.0, 1.0});
+    LatencySampler sampler(state);
+    std::size_t resting = 0;
+    for (auto _ : state)
+    {
+        if (!resting)
+        {
+            engine->place_batch(refill); // Untimed refill of the ask level
+            resting = refill.size();
+        }
+        sampler.measure([&]{ benchmark::DoNotOptimize(engine->place_order(OrderSide::BID, type, 100.0, 1.0)); });
+        --resting;
+    }
+    state.SetLabel(state.range(0) ? "market" : "limit");
+}
+BENCHMARK(BM_PlaceCrossing)->Arg(0)->Arg(1)->UseManualTime();
+
+// place_order: limit orders refused for a price off the tick grid (0) or a quantity off the lot grid (1)
+static void BM_RejectOffGrid(benchmark::State& state)
+{
+    const bool off_lot = state.range(0);
+    auto engine = make_engine();
+    LatencySampler sampler(state);
+    for (auto _ : state)
+    {
+        unsigned int id = 0;
+        sampler.measure([&]{ id = engine->place_order(OrderSide::BID, OrderType::LIMIT, off_lot ? 10.0 : 10.005, off_lot ? 1.5 : 1.0); });
+        if (id)
+        {
+            state.SkipWithError("Off-grid order was accepted");
+            break;
+        }
+    }
+    state.SetLabel(off_lot ? "off lot" : "off tick");
+}
+BENCHMARK(BM_RejectOffGrid)->Arg(0)->Arg(1)->UseManualTime();
+
+// place_order: one market order sweeping a level of N resting asks, reported per fill
+static void BM_SweepLevel(benchmark::State& state)
+{
+    const std::size_t orders = state.range(0);
+    auto engine = std::make_shared<OrderEngine>("BENCH", false);
+    const std::vector<OrderRequest> refill(orders, OrderRequest{"", OrderSide::ASK, OrderType::LIMIT, 100.0, 1.0});
+    LatencySampler sampler(state);
+    sampler.items_per_iteration = orders;
+    for (auto _ : state)
+    {
+        engine->place_batch(refill); // Untimed refill of the ask level
+        sampler.measure([&]{ benchmark::DoNotOptimize(engine->place_order(OrderSide::BID, OrderType::MARKET, -1, double(orders))); });
+    }
+}
+BENCHMARK(BM_SweepLevel)->Arg(10)->Arg(100)->Arg(500)->UseManualTime();
+
+// place_order: a subscribed sweep reporting more fills in one batch than the report ring holds
+static void BM_SweepReported(benchmark::State& state)
+{
+    const std::size_t orders = state.range(0);
+    std::atomic<std::uint64_t> delivered{0};
+    auto engine = std::make_shared<OrderEngine>("BENCH", false);
+    engine->subscribe_reports([&delivered](const ExecutionReport&) { delivered.fetch_add(1, std::memory_order_relaxed); });
+    const std::vector<OrderRequest> refill(orders, OrderRequest{"", OrderSide::ASK, OrderType::LIMIT, 100.0, 1.0});
+    LatencySampler sampler(state);
+    sampler.items_per_iteration = orders;
+    for (auto _ : state)
+    {
+        engine->place_batch(refill); // Untimed refill of the ask level
+        sampler.measure([&]{ benchmark::DoNotOptimize(engine->place_order(OrderSide::BID, OrderType::MARKET, -1, double(orders))); });
+    }
+    engine.reset(); // Deliver what is still queued
+    state.counters["reports"] = double(delivered.load());
+}
+BENCHMARK(BM_SweepReported)->Arg(100)->Arg(4096)->UseManualTime();
+
+// cancel_order: cancel from the middle of a level held at a fixed depth
+static void BM_CancelAtDepth(benchmark::State& state)
+{
+    const std::size_t depth = state.range(0);
+    auto engine = make_engine();
+    std::vector<unsigned int> level;
+    for (std::size_t i = 0; i < depth; ++i)
+        level.push_back(engine->place_order(OrderSide::BID, OrderType::LIMIT, 50.0, 1.0));
+
+    LatencySampler sampler(state);
+    std::mt19937 rng(42);
+    for (auto _ : state)
+    {
+        const std::size_t pick = rng() % level.size();
+        sampler.measure([&]{ benchmark::DoNotOptimize(engine->cancel_order(level[pick])); });
+        level[pick] = engine->place_order(OrderSide::BID, OrderType::LIMIT, 50.0, 1.0); // Untimed refill
+    }
+}
+BENCHMARK(BM_CancelAtDepth)->Arg(1)->Arg(10)->Arg(100)->Arg(1000)->UseManualTime();
+
+// edit_order: in-place qty-down (arg 0) and price move between two levels (arg 1) on a 100-order level
+static void BM_Amend(benchmark::State& state)
+{
+    const bool move = state.range(0);
+    auto engine = make_engine();
+    std::vector<unsigned int> level;
+    for (std::size_t i = 0; i < 100; ++i)
+        level.push_back(engine->place_order(OrderSide::BID, OrderType::LIMIT, 50.0, 1e9));
+
+    LatencySampler sampler(state);
+    std::mt19937 rng(42);
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        const unsigned int id = level[rng() % level.size()];
+        const double price = move ? 50.0 + double(i++ % 2) * 0.01 : 50.0;
+        const double qty = move ? 1e9 : 1e9 - double(++i);
+        sampler.measure([&]{ benchmark::DoNotOptimize(engine->edit_order(id, price, qty)); });
+    }
+    state.SetLabel(move ? "price move" : "qty down");
+}
+BENCHMARK(BM_Amend)->Arg(0)->Arg(1)->UseManualTime();
+
+// get_market_depth: top-N query on a book with 1000 bid levels of 5 orders each
+static void BM_MarketDepth(benchmark::State& state)
+{
+    auto engine = make_engine();
+    std::vector<OrderRequest> book;
+    for (int level = 0; level < 1000; ++level)
+        for (int n = 0; n < 5; ++n)
+            book.push_back(OrderRequest{"", OrderSide::BID, OrderType::LIMIT, 10.0 + level * 0.01, 1.0});
+    engine->place_batch(book);
+
+    LatencySampler sampler(state);
+    for (auto _ : state)
+        sampler.measure([&]{ benchmark::DoNotOptimize(engine->get_market_depth(OrderSide::BID, state.range(0))); });
+}
+BENCHMARK(BM_MarketDepth)->Arg(10)->Arg(100)->UseManualTime();
+
+// request_snapshot: L2 snapshot of a book with N ask levels, timed until SNAPSHOT_END reaches the subscriber
+static void BM_DepthSnapshot(benchmark::State& state)
+{
+    const std::size_t levels = state.range(0);
+    std::atomic<std::uint64_t> snapshots{0};
+    auto engine = std::make_shared<OrderEngine>("BENCH", false);
+    for (std::size_t i = 0; i < levels; ++i)
+        engine->place_order(OrderSide::ASK, OrderType::LIMIT, 100.0 + double(i) * 0.01, 1.0);
+    engine->subscribe_market_data([&snapshots](const BookUpdate& _update)
+    {
+        if (_update.action == BookAction::SNAPSHOT_END)
+            snapshots.fetch_add(1, std::memory_order_release);
+    });
+    while (!snapshots.load(std::memory_order_acquire))
+        std::this_thread::yield(); // Subscribing sends the first snapshot
+    LatencySampler sampler(state);
+    sampler.items_per_iteration = levels;
+    for (auto _ : state)
+    {
+        const std::uint64_t seen = snapshots.load(std::memory_order_acquire);
+        sampler.measure([&]{
+            engine->request_snapshot();
+            while (snapshots.load(std::memory_order_acquire) == seen)
+                std::this_thread::yield();
+        });
+    }
+}
+BENCHMARK(BM_DepthSnapshot)->Arg(100)->Arg(4096)->UseManualTime();
+
+// Exchange::limit_order routed across N tickers
+static void BM_ExchangeRouting(benchmark::State& state)
+{
+    const int tickers = state.range(0);
+    Exchange exchange(false);
+    std::vector<std::string> names;
+    for (int i = 0; i < tickers; ++i)
+    {
+        names.push_back("SYM" + std::to_string(i));
+        exchange.initialize_stock(names.back(), 1000.0, 1.0);
+    }
+
+    LatencySampler sampler(state);
+    std::mt19937 rng(7);
+    for (auto _ : state)
+    {
+        const std::string& ticker = names[rng() % names.size()];
+        const double price = 10.0 + double(rng() % 100) * 0.01;
+        sampler.measure([&]{ benchmark::DoNotOptimize(exchange.limit_order(ticker, OrderSide::BID, price, 1.0)); });
+    }
+}
+BENCHMARK(BM_ExchangeRouting)->Arg(1)->Arg(8)->Arg(64)->UseManualTime();
+
+// Opening burst of N crossing orders, matched continuously (arg 0) or collected in an auction call and uncrossed (arg 1)
+static void BM_OpeningBurst(benchmark::State& state)
+{
+    const bool auction = state.range(1);
+    std::vector<OrderRequest> burst;
+    std::mt19937 rng(11);
+    for (int i = 0; i < state.range(0); ++i)
+    {
+        const bool bid = i % 2;
+        const double price = 100.0 + (bid ? 1 : -1) * double(rng() % 50) * 0.01; // Bids above asks, every order crosses
+        burst.push_back(OrderRequest{"", bid ? OrderSide::BID : OrderSide::ASK, OrderType::LIMIT, price, double(1 + rng() % 10)});
+    }
+
+    LatencySampler sampler(state);
+    sampler.items_per_iteration = burst.size();
+    for (auto _ : state)
+    {
+        EngineConfig config;
+        config.auction = auction;
+        auto engine = std::make_shared<OrderEngine>("BENCH", false, config); // Untimed fresh book
+        sampler.measure([&]
+        {
+            benchmark::DoNotOptimize(engine->place_batch(burst));
+            if (auction)
+                benchmark::DoNotOptimize(engine->uncross());
+        });
+    }
+    state.SetLabel(auction ? "auction" : "continuous");
+}
+BENCHMARK(BM_OpeningBurst)->Args({1000, 0})->Args({1000, 1})->UseManualTime();
+
+// Exchange order entry through Symbol IDs from initialize_stock (no ticker hashing)
+static void BM_ExchangeRoutingById(benchmark::State& state)
+{
+    const int tickers = state.range(0);
+    Exchange exchange(false);
+    std::vector<SymbolId> symbols;
+    for (int i = 0; i < tickers; ++i)
+        symbols.push_back(exchange.initialize_stock("SYM" + std::to_string(i), 1000.0, 1.0));
+
+    LatencySampler sampler(state);
+    std::mt19937 rng(7);
+    for (auto _ : state)
+    {
+        const SymbolId symbol = symbols[rng() % symbols.size()];
+        const double price = 10.0 + double(rng() % 100) * 0.01;
+        sampler.measure([&]{ benchmark::DoNotOptimize(exchange.limit_order(symbol, OrderSide::BID, price, 1.0)); });
+    }
+}
+BENCHMARK(BM_ExchangeRoutingById)->Arg(1)->Arg(8)->Arg(64)->UseManualTime();
+
+// submit_order: fire-and-forget entry into the ingress ring
+static void BM_AsyncSubmit(benchmark::State& state)
+{
+    auto engine = make_engine();
+    LatencySampler sampler(state);
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        const double price = 10.0 + double(i++ % 100) * 0.01;
+        sampler.measure([&]{ benchmark::DoNotOptimize(engine->submit_order(OrderSide::BID, OrderType::LIMIT, price, 1.0)); });
+    }
+    engine->place_order(OrderSide::BID, OrderType::LIMIT, 10.0, 1.0); // Drain before teardown
+}
+BENCHMARK(BM_AsyncSubmit)->UseManualTime();
+
+// Exchange::submit_batch: batches spread over 8 tickers
+static void BM_SubmitBatch(benchmark::State& state)
+{
+    Exchange exchange(false);
+    std::vector<OrderRequest> batch;
+    for (int i = 0; i < 8; ++i)
+        exchange.initialize_stock("SYM" + std::to_string(i), 1000.0, 1.0);
+    for (int i = 0; i < state.range(0); ++i)
+        batch.push_back(OrderRequest{"SYM" + std::to_string(i % 8), OrderSide::BID, OrderType::LIMIT, 10.0 + (i % 100) * 0.01, 1.0});
+
+    LatencySampler sampler(state);
+    sampler.items_per_iteration = batch.size();
+    for (auto _ : state)
+        sampler.measure([&]{ benchmark::DoNotOptimize(exchange.submit_batch(batch)); });
+}
+BENCHMARK(BM_SubmitBatch)->Arg(64)->Arg(512)->UseManualTime();
+
+// Exchange::combo_order: all-or-none buy across N tickers, each leg lifting a deep IPO ask
+static void BM_ComboOrder(benchmark::State& state)
+{
+    Exchange exchange(false);
+    std::vector<OrderRequest> legs;
+    for (int i = 0; i < state.range(0); ++i)
+    {
+        exchange.initialize_stock("SYM" + std::to_string(i), 100.0, 1e9);
+        legs.push_back(OrderRequest{"SYM" + std::to_string(i), OrderSide::BID, OrderType::MARKET, 0, 1.0});
+    }
+
+    LatencySampler sampler(state);
+    sampler.items_per_iteration = legs.size();
+    for (auto _ : state)
+        sampler.measure([&]{ benchmark::DoNotOptimize(exchange.combo_order(legs)); });
+}
+BENCHMARK(BM_ComboOrder)->Arg(2)->Arg(4)->UseManualTime();
+
+// OrderGateway: a pipelined batch of N orders over loopback TCP, timed until every reply is back
+static void BM_GatewayBatch(benchmark::State& state)
+{
+    Exchange exchange(false);
+    exchange.initialize_stock("BENCH", 1000.0, 1.0);
+    OrderGateway gateway(&exchange);
+    GatewayClient client;
+    if (!gateway.start() || !client.connect("127.0.0.1", gateway.get_port()))
+    {
+        state.SkipWithError("Gateway unavailable");
+        return;
+    }
+    // Resolve the Symbol ID once, the batch carries it like a steady-state session would
+    std::vector<WireReply> replies;
+    if (!client.send(wire_resolve(0, "BENCH")) || !client.receive(replies, 1))
+    {
+        state.SkipWithError("Gateway unavailable");
+        return;
+    }
+    const SymbolId symbol = replies.front().order_id;
+    std::vector<WireRequest> batch;
+    for (int i = 0; i < state.range(0); ++i)
+        batch.push_back(wire_order(i, "BENCH", OrderSide::BID, OrderType::LIMIT, 10.0 + (i % 100) * 0.01, 1.0, symbol));
+
+    LatencySampler sampler(state);
+    sampler.items_per_iteration = batch.size();
+    for (auto _ : state)
+    {
+        replies.clear();
+        sampler.measure([&]{ client.send(batch); client.receive(replies, batch.size()); });
+    }
+    client.close();
+}
+BENCHMARK(BM_GatewayBatch)->Arg(1)->Arg(64)->UseManualTime();
+
+// RiskGate: a batch of N orders for one account, checked on the risk thread and timed until every ack
+static void BM_RiskGateBatch(benchmark::State& state)
+{
+    Exchange exchange(false);
+    const SymbolId symbol = exchange.initialize_stock("BENCH", 1000.0, 1.0);
+    RiskGate gate(&exchange, RiskConfig(), false);
+    RiskLimits limits;
+    limits.max_order_qty = 100;
+    limits.max_order_notional = 1e6;
+    limits.max_position = 1e12;
+    gate.set_limits(1, limits);
+
+    LatencySampler sampler(state);
+    sampler.items_per_iteration = state.range(0);
+    for (auto _ : state)
+    {
+        sampler.measure([&]
+        {
+            AckLatch latch(state.range(0));
+            for (int i = 0; i < state.range(0); ++i)
+                gate.submit_order(1, symbol, OrderSide::BID, OrderType::LIMIT, 10.0 + (i % 100) * 0.01, 1.0, [&latch](const OrderAck&) { latch.count_down(); });
+            latch.wait();
+        });
+    }
+}
+BENCHMARK(BM_RiskGateBatch)->Arg(1)->Arg(64)->UseManualTime();
+
+BENCHMARK_MAIN();
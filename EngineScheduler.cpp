@@ -0,0 +1,299 @@
+#pragma once
+#include "OrderEngine.cpp"
+#include <algorithm>
+#include <functional>
+
+// Shard Policies (which worker a newly listed engine lands on)
+enum class ShardPolicy
+{
+    ROUND_ROBIN, // Workers in turn
+    HASH, // Hash of the ticker, stable across restarts
+    LEAST_LOADED // Worker with the fewest commands processed by its engines
+};
+
+// Scheduler Configuration
+struct SchedulerConfig
+{
+    std::size_t workers = 0; // Worker threads (0 uses one per core)
+    ShardPolicy policy = ShardPolicy::ROUND_ROBIN; // Placement of new engines
+    WaitStrategy wait_strategy = WaitStrategy::BLOCKING; // How workers idle between commands
+    bool pin_workers = false; // Pin worker i to core i
+};
+
+// Engine Scheduler
+// A fixed set of worker threads, each draining the ingress queues of the engines in its shard one batch
+// at a time. Engines can move between workers while they trade (rebalance), a try-lock in OrderEngine::poll
+// hands their queue from one worker to the next. Taking an engine off a worker waits for that worker to let go of
+// it, so detach, assign and rebalance throw when called from a worker (a pooled engine's callback) instead of
+// waiting on themselves
+class EngineScheduler
+{
+public:
+    EngineScheduler(const SchedulerConfig& _config = SchedulerConfig())
+    : policy(_config.policy), wait_strategy(_config.wait_strategy), next_worker(0), running(true)
+    {
+        std::size_t count = _config.workers ? _config.workers : std::max(1u, std::thread::hardware_concurrency());
+        for (std::size_t i = 0; i < count; ++i)
+            workers.push_back(std::make_unique<Worker>());
+        for (std::size_t i = 0; i < count; ++i)
+            workers[i]->thread = std::thread(&EngineScheduler::work, this, i, _config.pin_workers ? int(i) : -1);
+    }
+
+    ~EngineScheduler()
+    {
+        // Engines still attached go back to dedicated threads
+        std::vector<std::shared_ptr<OrderEngine>> attached;
+        {
+            std::lock_guard<std::mutex> lock(placement_lock);
+            for (auto& [engine, placed] : placements)
+                attached.push_back(placed.engine.lock());
+        }
+        for (auto& engine : attached)
+            if (engine)
+                detach(engine);
+
+        running = false;
+        for (auto& worker : workers)
+        {
+            worker->signal.notify_all();
+            worker->thread.join();
+        }
+    }
+
+    EngineScheduler(const EngineScheduler&) = delete;
+    EngineScheduler& operator=(const EngineScheduler&) = delete;
+
+    // Hand a pooled Engine to a worker chosen by the shard policy
+    void attach(const std::shared_ptr<OrderEngine>& _engine, const std::string& _ticker)
+    {
+        std::lock_guard<std::mutex> lock(placement_lock);
+        if (placements.count(_engine.get()))
+            return;
+        std::size_t worker = 0;
+        switch (policy)
+        {
+            case ShardPolicy::ROUND_ROBIN:
+                worker = next_worker++ % workers.size();
+                break;
+
+            case ShardPolicy::HASH:
+                worker = std::hash<std::string>()(_ticker) % workers.size();
+                break;
+
+            case ShardPolicy::LEAST_LOADED:
+                worker = least_loaded();
+                break;
+        }
+        placements.emplace(_engine.get(), Placement{_engine, worker, _engine->get_commands_processed()});
+        place(_engine.get(), worker);
+    }
+
+    // Take an Engine out of the pool. It drains on a dedicated thread from now on, or (_dedicated false,
+    // for engines about to be destroyed) in its destructor. Attached engines must be detached before destruction
+    void detach(const std::shared_ptr<OrderEngine>& _engine, const bool _dedicated = true)
+    {
+        check_caller();
+        std::lock_guard<std::mutex> lock(placement_lock);
+        auto placed = placements.find(_engine.get());
+        if (placed == placements.end())
+            return;
+        unplace(_engine.get(), placed->second.worker);
+        placements.erase(placed);
+        if (_dedicated)
+            _engine->detach();
+    }
+
+    // Move an Engine to a specific worker (pin a hot symbol), false if unknown
+    bool assign(const std::shared_ptr<OrderEngine>& _engine, const std::size_t _worker)
+    {
+        check_caller();
+        std::lock_guard<std::mutex> lock(placement_lock);
+        auto placed = placements.find(_engine.get());
+        if (placed == placements.end() || _worker >= workers.size())
+            return false;
+        move(placed->second, _worker);
+        return true;
+    }
+
+    // Rebalance by recent load: engines sorted by commands processed since the last rebalance are dealt
+    // greedily to the least busy worker. Returns how many engines moved
+    std::size_t rebalance()
+    {
+        check_caller();
+        std::lock_guard<std::mutex> lock(placement_lock);
+        std::vector<std::pair<std::uint64_t, Placement*>> loads;
+        for (auto& [engine, placed] : placements)
+        {
+            const std::uint64_t processed = engine->get_commands_processed();
+            loads.emplace_back(processed - placed.last_processed, &placed);
+            placed.last_processed = processed;
+        }
+        std::sort(loads.begin(), loads.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+        std::vector<std::uint64_t> worker_load(workers.size(), 0);
+        std::size_t moved = 0;
+        for (auto& [load, placed] : loads)
+        {
+            const std::size_t target = std::min_element(worker_load.begin(), worker_load.end()) - worker_load.begin();
+            worker_load[target] += load + 1; // +1 so idle engines still spread out
+            if (target != placed->worker)
+            {
+                move(*placed, target);
+                ++moved;
+            }
+        }
+        return moved;
+    }
+
+    // GET: Worker an Engine runs on (-1 if not attached)
+    int get_worker(const std::shared_ptr<OrderEngine>& _engine) const
+    {
+        std::lock_guard<std::mutex> lock(placement_lock);
+        auto placed = placements.find(_engine.get());
+        return placed == placements.end() ? -1 : int(placed->second.worker);
+    }
+
+    std::size_t get_worker_count() const { return workers.size(); }
+
+    // GET: Is the calling thread one of this scheduler's workers (where pooled engines run their callbacks)
+    bool on_worker() const { return current == this; }
+
+private:
+    struct Worker
+    {
+        std::thread thread;
+        WakeSignal signal; // Engines in the shard wake the worker through this
+        std::mutex shard_lock; // Guards shard
+        std::vector<OrderEngine*> shard; // Engines this worker drains
+        std::atomic<std::uint64_t> shard_version{0}; // Bumped on every shard change
+        std::atomic<std::uint64_t> seen_version{0}; // Last shard version the worker picked up
+    };
+
+    struct Placement
+    {
+        std::weak_ptr<OrderEngine> engine;
+        std::size_t worker;
+        std::uint64_t last_processed; // Commands processed at the last rebalance
+    };
+
+    const ShardPolicy policy;
+    const WaitStrategy wait_strategy;
+    std::vector<std::unique_ptr<Worker>> workers;
+    mutable std::mutex placement_lock; // Guards placements and serialises moves
+    std::unordered_map<OrderEngine*, Placement> placements;
+    std::size_t next_worker; // Round-robin cursor
+    std::atomic<bool> running;
+    static inline thread_local const EngineScheduler* current = nullptr; // Scheduler the calling thread works for
+
+    // Throw if a worker asks to move engines: it would wait for itself (or, blocked on placement_lock, hold up the
+    // worker the caller waits for) to pick up the change
+    void check_caller() const
+    {
+        if (on_worker())
+            throw std::runtime_error("Scheduler Change From A Worker Thread");
+    }
+
+    std::size_t least_loaded() const
+    {
+        std::vector<std::uint64_t> worker_load(workers.size(), 0);
+        for (auto& [engine, placed] : placements)
+            worker_load[placed.worker] += engine->get_commands_processed() + 1;
+        return std::min_element(worker_load.begin(), worker_load.end()) - worker_load.begin();
+    }
+
+    // Move an Engine between workers (placement_lock held)
+    void move(Placement& placed, const std::size_t _worker)
+    {
+        if (placed.worker == _worker)
+            return;
+        auto engine = placed.engine.lock();
+        if (!engine)
+            return;
+        unplace(engine.get(), placed.worker);
+        place(engine.get(), _worker);
+        placed.worker = _worker;
+    }
+
+    // Add an Engine to a worker's shard and route its wakeups there
+    void place(OrderEngine* engine, const std::size_t _worker)
+    {
+        Worker& worker = *workers[_worker];
+        engine->attach(&worker.signal);
+        {
+            std::lock_guard<std::mutex> lock(worker.shard_lock);
+            worker.shard.push_back(engine);
+            worker.shard_version.fetch_add(1);
+        }
+        worker.signal.notify(); // Picks up commands queued while the engine was between workers
+    }
+
+    // Remove an Engine from a worker's shard, returns once the worker no longer touches it
+    void unplace(OrderEngine* engine, const std::size_t _worker)
+    {
+        Worker& worker = *workers[_worker];
+        std::uint64_t version;
+        {
+            std::lock_guard<std::mutex> lock(worker.shard_lock);
+            worker.shard.erase(std::find(worker.shard.begin(), worker.shard.end(), engine));
+            version = worker.shard_version.fetch_add(1) + 1;
+        }
+        while (worker.seen_version.load() < version)
+        {
+            worker.signal.notify();
+            std::this_thread::yield();
+        }
+    }
+
+    // Worker: drain every engine in the shard once per round, idle when a whole round found nothing
+    void work(const std::size_t _index, const int _core)
+    {
+        if (_core >= 0 && !pin_current_thread(_core))
+            std::cerr << "Failed to pin scheduler worker " << _index << " to core " << _core << '\n';
+
+        current = this;
+        Worker& worker = *workers[_index];
+        std::vector<OrderEngine*> shard;
+        std::uint64_t version = 0;
+        while (true)
+        {
+            // Pick up shard changes between rounds, never mid-poll
+            const std::uint64_t current = worker.shard_version.load();
+            if (current != version)
+            {
+                std::lock_guard<std::mutex> lock(worker.shard_lock);
+                shard = worker.shard;
+                version = worker.shard_version.load();
+                worker.seen_version.store(version);
+            }
+
+            bool worked = false;
+            for (OrderEngine* engine : shard)
+                worked |= engine->poll();
+            if (worked)
+                continue;
+
+            if (!running)
+                return;
+
+            switch (wait_strategy)
+            {
+                case WaitStrategy::BUSY_SPIN:
+                    cpu_relax();
+                    break;
+
+                case WaitStrategy::YIELD:
+                    std::this_thread::yield();
+                    break;
+
+                case WaitStrategy::BLOCKING:
+                    worker.signal.wait([&]
+                    {
+                        if (!running || worker.shard_version.load() != version)
+                            return true;
+                        return std::any_of(shard.begin(), shard.end(), [](const OrderEngine* engine) { return engine->has_work(); });
+                    });
+                    break;
+            }
+        }
+    }
+};
@@ -0,0 +1,204 @@
+#pragma once
+#include "RingBuffer.cpp"
+#include "MappedFile.cpp"
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <cstdio>
+#include <type_traits>
+
+// Binary Event Stream
+// The engine thread publishes fixed-size records into an SPSC ring and nothing else: no formatting,
+// no allocation, no I/O. A consumer thread (started with the first subscriber) drains the ring to
+// subscriber callbacks and binary record files. With no subscribers, publish is a single flag check and the ring
+// is never allocated
+template <typename T>
+class EventStream
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Event records are copied through the ring and written raw");
+
+public:
+    using Subscriber = std::function<void(const T&)>;
+
+    EventStream(const std::size_t _capacity)
+    : capacity(_capacity), active(false), stopping(false), consumer_sleeping(false)
+    {
+    }
+
+    ~EventStream()
+    {
+        stop();
+        for (const RecordFile& sink : files)
+            std::fclose(sink.file);
+    }
+
+    EventStream(const EventStream&) = delete;
+    EventStream& operator=(const EventStream&) = delete;
+
+    // Add a Subscriber (runs on the consumer thread), returns its handle for unsubscribe
+    std::uint64_t subscribe(Subscriber _subscriber)
+    {
+        std::lock_guard<std::mutex> lock(sink_lock);
+        subscribers.push_back({++last_subscription, std::move(_subscriber)});
+        start();
+        return last_subscription;
+    }
+
+    // Remove a Subscriber. It is not called again once this returns (waits out a drain in progress), so it must not
+    // be called from a subscriber
+    void unsubscribe(const std::uint64_t _handle)
+    {
+        std::lock_guard<std::mutex> lock(sink_lock);
+        std::erase_if(subscribers, [_handle](const Subscription& _subscription) { return _subscription.handle == _handle; });
+    }
+
+    // Append every Record to a binary file
+    // Durable files are synced to disk once per drained batch (group commit), off the producer thread
+    bool record_to(const std::string& _path, const bool _durable = false)
+    {
+        FILE* file = std::fopen(_path.c_str(), "ab");
+        if (!file)
+            return false;
+        std::lock_guard<std::mutex> lock(sink_lock);
+        files.push_back(RecordFile{file, _durable});
+        start();
+        return true;
+    }
+
+    // Is anyone listening (acquire, so a producer that sees it also sees the ring)
+    bool enabled() const { return active.load(std::memory_order_acquire); }
+
+    // Publish a Record (producer thread only), backs off while the consumer catches up
+    // A batch can outgrow the ring, so a full ring wakes the consumer rather than waiting for the end-of-batch notify
+    void publish(const T& _record)
+    {
+        if (!enabled())
+            return;
+        while (!ring->try_push(_record))
+        {
+            notify();
+            std::this_thread::yield();
+        }
+    }
+
+    // Wake the Consumer if it is asleep (producer calls this once per batch, and whenever the ring fills)
+    void notify()
+    {
+        if (!consumer_sleeping.load())
+            return;
+        std::lock_guard<std::mutex> lock(wake_lock);
+        wake_cv.notify_one();
+    }
+
+    // Drain what is queued and stop the Consumer
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wake_lock);
+            stopping = true;
+        }
+        wake_cv.notify_all();
+        if (consumer.joinable())
+            consumer.join();
+    }
+
+private:
+    std::unique_ptr<SPSCRing<T>> ring; // Allocated by the first subscriber or file
+    const std::size_t capacity;
+    std::atomic<bool> active;
+    std::thread consumer;
+    std::mutex sink_lock; // Guards subscribers and files
+    struct Subscription
+    {
+        std::uint64_t handle;
+        Subscriber callback;
+    };
+    std::vector<Subscription> subscribers;
+    std::uint64_t last_subscription = 0;
+    struct RecordFile
+    {
+        FILE* file;
+        bool durable; // Sync to disk after each flush
+    };
+    std::vector<RecordFile> files;
+    std::mutex wake_lock;
+    std::condition_variable wake_cv;
+    std::atomic<bool> stopping;
+    std::atomic<bool> consumer_sleeping;
+
+    // Start the Consumer on first use (sink_lock held)
+    void start()
+    {
+        if (active.load())
+            return;
+        ring = std::make_unique<SPSCRing<T>>(capacity);
+        consumer = std::thread(&EventStream::consume, this);
+        active.store(true);
+    }
+
+    void consume()
+    {
+        T record;
+        while (true)
+        {
+            bool drained = false;
+            {
+                std::lock_guard<std::mutex> lock(sink_lock);
+                while (ring->try_pop(record))
+                {
+                    drained = true;
+                    for (auto& subscriber : subscribers)
+                        subscriber.callback(record);
+                    for (const RecordFile& sink : files)
+                        std::fwrite(&record, sizeof(T), 1, sink.file);
+                }
+                if (drained)
+                {
+                    for (const RecordFile& sink : files)
+                    {
+                        std::fflush(sink.file); // Flush once per drained batch
+                        if (sink.durable)
+                            sync_file(sink.file);
+                    }
+                }
+            }
+            if (drained)
+                continue;
+            if (stopping)
+                return; // Shut down once the ring is drained
+
+            // Sleep until the producer publishes
+            std::unique_lock<std::mutex> lock(wake_lock);
+            consumer_sleeping.store(true);
+            wake_cv.wait(lock, [this]{ return stopping || ring->pending(); });
+            consumer_sleeping.store(false);
+        }
+    }
+};
+
+// Read a binary file of Records written by EventStream::record_to, returns how many whole Records were read
+// A torn Record at the end (crash mid-write) is ignored
+template <typename T, typename Fn>
+std::size_t read_records(const std::string& _path, Fn&& _on_record)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Records are read back raw");
+    FILE* file = std::fopen(_path.c_str(), "rb");
+    if (!file)
+        return 0;
+    std::vector<T> chunk(4096);
+    std::size_t total = 0;
+    std::size_t read;
+    while ((read = std::fread(chunk.data(), sizeof(T), chunk.size(), file)))
+    {
+        for (std::size_t i = 0; i < read; ++i)
+            _on_record(chunk[i]);
+        total += read;
+    }
+    std::fclose(file);
+    return total;
+}
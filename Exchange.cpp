@@ -1,62 +1,113 @@
 #pragma once
-#include "OrderEngine.cpp"
+#include "EngineScheduler.cpp"
+#include "SymbolDirectory.cpp"
+#include <string_view>
+#include <filesystem>
 
-using OrderEngines = std::unordered_map<std::string, std::shared_ptr<OrderEngine>>;
+using OrderEngines = SymbolDirectory<OrderEngine>; // Ticker -> Engine, wait-free lookups by Symbol ID
+
+// Combo Order Outcome, legs line up with the request (id 0 / REJECTED for every leg if it did not trade)
+struct ComboResult
+{
+    bool filled = false;
+    double net_price = 0; // Buys minus sells at the leg fill prices (negative for a net credit)
+    std::vector<OrderAck> legs;
+};
 
 class Exchange
 {
     public:
-        Exchange(bool _verbose = true)
-        : verbose(_verbose)
+        Exchange(bool _verbose = true, const SchedulerConfig& _scheduler = SchedulerConfig())
+        : Scheduler(std::make_unique<EngineScheduler>(_scheduler)), verbose(_verbose)
         { 
         }
         
         ~Exchange()
         {
+            // Engines shared outside the Exchange keep trading on dedicated threads, the rest drain as they go
+            for (auto& ticker : get_tradable_tickers())
+                if (auto engine = StockExchange.erase(ticker))
+                    Scheduler->detach(engine, engine.use_count() > 1);
+        }
+
+        // List a Stock, returns its Symbol ID for the handle overloads below (0 if it could not be listed)
+        SymbolId initialize_stock(const std::string& _ticker, double _ipo_price, double _ipo_qty, double _tick_size = 0.01, double _lot_size = 1.0)
+        {
+            EngineConfig config;
+            config.tick_size = _tick_size;
+            config.lot_size = _lot_size;
+            return initialize_stock(_ticker, _ipo_price, _ipo_qty, config);
         }
 
-        bool initialize_stock(const std::string& _ticker, double _ipo_price, double _ipo_qty)
+        SymbolId initialize_stock(const std::string& _ticker, double _ipo_price, double _ipo_qty, const EngineConfig& _config)
         {
             try
             {
+                // If called from a scheduler worker (a pooled engine's callback), it would wait on itself
+                if (Scheduler->on_worker())
+                    throw std::runtime_error("Called From A Scheduler Worker");
                 // IF ipo price or qty is less than or equal to 0
                 if (_ipo_price <= 0.0 || _ipo_qty <= 0.0)
                     throw std::runtime_error("IPO Price/Quantity must be > 0");
+                // If tick size is less than or equal to 0
+                if (_config.tick_size <= 0.0)
+                    throw std::runtime_error("Tick Size must be > 0");
+                // If lot size is less than or equal to 0
+                if (_config.lot_size <= 0.0)
+                    throw std::runtime_error("Lot Size must be > 0");
                 // If ticker is already in Exchange then error
-                if (StockExchange.find(_ticker) != StockExchange.end())
+                if (StockExchange.contains(_ticker))
                     throw std::runtime_error("Stock Already Exist");
 
-                auto engine = std::make_shared<OrderEngine>(std::move(_ticker), verbose); // verbose mode
+                EngineConfig config = _config;
+                config.pooled = pooled(config);
+                auto engine = std::make_shared<OrderEngine>(_ticker, verbose, config); // verbose mode
                 if (!engine)
                     throw std::runtime_error("Null Matching Engine");
+                if (config.pooled)
+                    Scheduler->attach(engine, _ticker);
 
-                // Place initial sell at IPO Price and IPO Quantitiy
-                auto ipo_order = engine->place_order(OrderSide::ASK, OrderType::LIMIT, _ipo_price, _ipo_qty);
-                // If no Order then error
-                if (!ipo_order)
-                    throw std::runtime_error("IPO Order Failed to Place");
-                StockExchange.emplace(_ticker, std::move(engine));
-                return true;
+                // Place initial sell at IPO Price and IPO Quantitiy (a recovered book already holds it)
+                if (!engine->get_recovered())
+                {
+                    auto ipo_order = engine->place_order(OrderSide::ASK, OrderType::LIMIT, _ipo_price, _ipo_qty);
+                    // If no Order then error
+                    if (!ipo_order)
+                        throw std::runtime_error("IPO Order Failed to Place");
+                }
+                // Lost a race with another listing of the same ticker
+                const SymbolId symbol = StockExchange.insert(_ticker, engine);
+                if (!symbol)
+                {
+                    Scheduler->detach(engine, false);
+                    throw std::runtime_error("Stock Already Exist");
+                }
+                return symbol;
             }
             catch(const std::exception& e)
             {
                 if (verbose)
                     std::cerr << "Stock Initlization Error: " << e.what() << '\n';
-                return false;
+                return 0;
             }
         }
 
+        // Ticker overloads resolve the Symbol ID (one hash) and forward, hot callers keep the ID instead
         unsigned int limit_order(const std::string& _ticker, OrderSide _side, double _price, double _qty) const
+        {
+            return limit_order(StockExchange.id_of(_ticker), _side, _price, _qty);
+        }
+
+        unsigned int limit_order(SymbolId _symbol, OrderSide _side, double _price, double _qty) const
         {
             try
             {
-                if (StockExchange.find(_ticker) == StockExchange.end()) 
-                    throw std::runtime_error("Stock Does Not Exist");
+                auto engine = listed(_symbol);
                 // If price or qty less than or equal to 0
                 if (_price <= 0 || _qty <= 0)
                     throw std::runtime_error("Price/Quantity must be > 0");
                 
-                auto order = StockExchange.at(_ticker)->place_order(_side, OrderType::LIMIT, _price, _qty);
+                auto order = engine->place_order(_side, OrderType::LIMIT, _price, _qty);
                 // If no Order then error
                 if (!order)
                     throw std::runtime_error("Order Failed to Place");
@@ -71,16 +122,20 @@ class Exchange
         }
 
         unsigned int market_order(const std::string& _ticker, OrderSide _side, double _qty) const
+        {
+            return market_order(StockExchange.id_of(_ticker), _side, _qty);
+        }
+
+        unsigned int market_order(SymbolId _symbol, OrderSide _side, double _qty) const
         {
             try
             {
-                if (StockExchange.find(_ticker) == StockExchange.end()) 
-                    throw std::runtime_error("Stock Does Not Exist");
+                auto engine = listed(_symbol);
                 // If qty less than or equal to 0
                 if (_qty <= 0)
                     throw std::runtime_error("Price/Quantity must be > 0");
                 
-                auto order = StockExchange.at(_ticker)->place_order(_side, OrderType::MARKET, -1, _qty);
+                auto order = engine->place_order(_side, OrderType::MARKET, -1, _qty);
                 // If no Order then error
                 if (!order)
                     throw std::runtime_error("Order Failed to Place");
@@ -95,13 +150,17 @@ class Exchange
         }
 
         bool cancel_order(const std::string& _ticker, unsigned int order_id) const
+        {
+            return cancel_order(StockExchange.id_of(_ticker), order_id);
+        }
+
+        bool cancel_order(SymbolId _symbol, unsigned int order_id) const
         {
             try
             {
-                if (StockExchange.find(_ticker) == StockExchange.end()) 
-                    throw std::runtime_error("Stock Does Not Exist");
+                auto engine = listed(_symbol);
                 
-                auto is_canceled = StockExchange.at(_ticker)->cancel_order(order_id);
+                auto is_canceled = engine->cancel_order(order_id);
                 // If canceled failed then error
                 if (!is_canceled)
                     throw std::runtime_error("Order Failed to Cancel");
@@ -115,14 +174,19 @@ class Exchange
             }
         }
 
-        unsigned int edit_order(const std::string& _ticker, unsigned int order_id, OrderSide _side, double _price, double _qty) const
+        // Amend in place, outside any RiskGate (orders entered through a gate amend through RiskGate::submit_amend)
+        unsigned int edit_order(const std::string& _ticker, unsigned int order_id, double _price, double _qty) const
+        {
+            return edit_order(StockExchange.id_of(_ticker), order_id, _price, _qty);
+        }
+
+        unsigned int edit_order(SymbolId _symbol, unsigned int order_id, double _price, double _qty) const
         {
             try
             {
-                if (StockExchange.find(_ticker) == StockExchange.end()) 
-                    throw std::runtime_error("Stock Does Not Exist");
+                auto engine = listed(_symbol);
                 
-                auto order = StockExchange.at(_ticker)->edit_order(order_id, _side, _price, _qty);
+                auto order = engine->edit_order(order_id, _price, _qty);
                 // If no Order then error
                 if (!order)
                     throw std::runtime_error("Order Failed to Edit");
@@ -136,14 +200,141 @@ class Exchange
             }
         }
 
-        std::shared_ptr<OrderInfo> get_order(const std::string& _ticker, unsigned int order_id) const
+        // ASYNC: Submit an Order without waiting, acknowledged by callback on the engine's thread.
+        // Returns its Order ID (0 if refused here, the callback then never runs)
+        unsigned int submit_order(const std::string& _ticker, OrderSide _side, OrderType _type, double _price, double _qty, AckCallback _on_ack = nullptr) const
+        {
+            return submit_order(StockExchange.id_of(_ticker), _side, _type, _price, _qty, std::move(_on_ack));
+        }
+
+        unsigned int submit_order(SymbolId _symbol, OrderSide _side, OrderType _type, double _price, double _qty, AckCallback _on_ack = nullptr) const
         {
             try
             {
-                if (StockExchange.find(_ticker) == StockExchange.end()) 
-                    throw std::runtime_error("Stock Does Not Exist");
+                auto engine = listed(_symbol);
+                // If price (limit) or qty less than or equal to 0
+                if (_qty <= 0 || (_type == OrderType::LIMIT && _price <= 0))
+                    throw std::runtime_error("Price/Quantity must be > 0");
+                return engine->submit_order(_side, _type, _price, _qty, std::move(_on_ack));
+            }
+            catch(const std::exception& e)
+            {
+                if (verbose)
+                    std::cerr << "Submit Order Error: " << e.what() << '\n';
+                return 0;
+            }
+        }
 
-                auto order = StockExchange.at(_ticker)->get_order(order_id);
+        // ASYNC: Submit a Cancel without waiting, false if refused here (the callback then never runs)
+        bool submit_cancel(const std::string& _ticker, unsigned int order_id, AckCallback _on_ack = nullptr) const
+        {
+            return submit_cancel(StockExchange.id_of(_ticker), order_id, std::move(_on_ack));
+        }
+
+        bool submit_cancel(SymbolId _symbol, unsigned int order_id, AckCallback _on_ack = nullptr) const
+        {
+            try
+            {
+                auto engine = listed(_symbol);
+                engine->submit_cancel(order_id, std::move(_on_ack));
+                return true;
+            }
+            catch(const std::exception& e)
+            {
+                if (verbose)
+                    std::cerr << "Submit Cancel Error: " << e.what() << '\n';
+                return false;
+            }
+        }
+
+        // ASYNC: Submit an Amend without waiting, false if refused here (the callback then never runs). Not risk checked, see edit_order
+        bool submit_amend(const std::string& _ticker, unsigned int order_id, double _price, double _qty, AckCallback _on_ack = nullptr) const
+        {
+            return submit_amend(StockExchange.id_of(_ticker), order_id, _price, _qty, std::move(_on_ack));
+        }
+
+        bool submit_amend(SymbolId _symbol, unsigned int order_id, double _price, double _qty, AckCallback _on_ack = nullptr) const
+        {
+            try
+            {
+                auto engine = listed(_symbol);
+                // If price or qty less than or equal to 0
+                if (_price <= 0 || _qty <= 0)
+                    throw std::runtime_error("Price/Quantity must be > 0");
+                engine->submit_amend(order_id, _price, _qty, std::move(_on_ack));
+                return true;
+            }
+            catch(const std::exception& e)
+            {
+                if (verbose)
+                    std::cerr << "Submit Amend Error: " << e.what() << '\n';
+                return false;
+            }
+        }
+
+        // Open an Auction Call on a Stock (opening/closing cross), see OrderEngine::start_auction
+        bool start_auction(const std::string& _ticker) const
+        {
+            return start_auction(StockExchange.id_of(_ticker));
+        }
+
+        bool start_auction(SymbolId _symbol) const
+        {
+            try
+            {
+                auto engine = listed(_symbol);
+                // If already in an auction call
+                if (!engine->start_auction())
+                    throw std::runtime_error("Auction Already Open");
+                return true;
+            }
+            catch(const std::exception& e)
+            {
+                if (verbose)
+                    std::cerr << "Start Auction Error: " << e.what() << '\n';
+                return false;
+            }
+        }
+
+        // Uncross a Stock's Auction Call and resume continuous trading, see OrderEngine::uncross
+        // The quote is in raw units: price in ticks, quantities in lots (see get_tick_size / get_lot_size)
+        std::optional<AuctionQuote> uncross(const std::string& _ticker) const
+        {
+            return uncross(StockExchange.id_of(_ticker));
+        }
+
+        std::optional<AuctionQuote> uncross(SymbolId _symbol) const
+        {
+            try
+            {
+                auto engine = listed(_symbol);
+                auto result = engine->uncross();
+                // If no auction call was open
+                if (!result)
+                    throw std::runtime_error("No Auction Open");
+                return result;
+            }
+            catch(const std::exception& e)
+            {
+                if (verbose)
+                    std::cerr << "Uncross Error: " << e.what() << '\n';
+                return std::nullopt;
+            }
+        }
+
+        // Order record in raw units: price in ticks, qty in lots (see get_tick_size / get_lot_size)
+        std::optional<OrderInfo> get_order(const std::string& _ticker, unsigned int order_id) const
+        {
+            return get_order(StockExchange.id_of(_ticker), order_id);
+        }
+
+        std::optional<OrderInfo> get_order(SymbolId _symbol, unsigned int order_id) const
+        {
+            try
+            {
+                auto engine = listed(_symbol);
+
+                auto order = engine->get_order(order_id);
                 // If no Order then error
                 if (!order)
                     throw std::runtime_error("Failed to Get Order");
@@ -153,18 +344,22 @@ class Exchange
             {
                 if (verbose)
                     std::cerr << "Get Order Error: " << e.what() << '\n';
-                return nullptr;
+                return std::nullopt;
             }
         }
 
         double get_price(const std::string& _ticker) const
+        {
+            return get_price(StockExchange.id_of(_ticker));
+        }
+
+        double get_price(SymbolId _symbol) const
         {
             try
             {
-                if (StockExchange.find(_ticker) == StockExchange.end()) 
-                    throw std::runtime_error("Stock Does Not Exist");
+                auto engine = listed(_symbol);
                 
-                return StockExchange.at(_ticker)->get_price();
+                return engine->get_price();
             }
             catch(const std::exception& e)
             {
@@ -175,13 +370,17 @@ class Exchange
         }
 
         double get_best_bid(const std::string& _ticker) const
+        {
+            return get_best_bid(StockExchange.id_of(_ticker));
+        }
+
+        double get_best_bid(SymbolId _symbol) const
         {
             try
             {
-                if (StockExchange.find(_ticker) == StockExchange.end()) 
-                    throw std::runtime_error("Stock Does Not Exist");
+                auto engine = listed(_symbol);
 
-                auto best_bid = StockExchange.at(_ticker)->get_best_bid();
+                auto best_bid = engine->get_best_bid();
                 // If no best bid then error
                 if (best_bid == -1)
                     throw std::runtime_error("Bid Side is Empty");
@@ -196,13 +395,17 @@ class Exchange
         }
 
         double get_best_ask(const std::string& _ticker) const
+        {
+            return get_best_ask(StockExchange.id_of(_ticker));
+        }
+
+        double get_best_ask(SymbolId _symbol) const
         {
             try
             {
-                if (StockExchange.find(_ticker) == StockExchange.end()) 
-                    throw std::runtime_error("Stock Does Not Exist");
+                auto engine = listed(_symbol);
                 
-                auto best_ask = StockExchange.at(_ticker)->get_best_ask();
+                auto best_ask = engine->get_best_ask();
                 // If no best ask then error
                 if (best_ask == -1)
                     throw std::runtime_error("Ask Side is Empty");
@@ -216,13 +419,39 @@ class Exchange
             }
         }
 
-        std::vector<std::shared_ptr<OrderInfo>> get_orders_by_status(const std::string& _ticker, OrderStatus status) const
+        // Top of Book in raw units: prices in ticks, quantities in lots (see get_tick_size / get_lot_size)
+        std::optional<TopOfBook> get_top_of_book(const std::string& _ticker) const
+        {
+            return get_top_of_book(StockExchange.id_of(_ticker));
+        }
+
+        std::optional<TopOfBook> get_top_of_book(SymbolId _symbol) const
         {
             try
             {
-                if (StockExchange.find(_ticker) == StockExchange.end()) 
-                    throw std::runtime_error("Stock Does Not Exist");
-                return StockExchange.at(_ticker)->get_orders_by_status(status);
+                auto engine = listed(_symbol);
+                return engine->get_top_of_book();
+            }
+            catch(const std::exception& e)
+            {
+                if (verbose)
+                    std::cerr << "Get Top Of Book Error: " << e.what() << '\n';
+                return std::nullopt;
+            }
+        }
+
+        // Order records in raw units, as get_order
+        std::vector<OrderInfo> get_orders_by_status(const std::string& _ticker, OrderStatus status) const
+        {
+            return get_orders_by_status(StockExchange.id_of(_ticker), status);
+        }
+
+        std::vector<OrderInfo> get_orders_by_status(SymbolId _symbol, OrderStatus status) const
+        {
+            try
+            {
+                auto engine = listed(_symbol);
+                return engine->get_orders_by_status(status);
             }
             catch(const std::exception& e)
             {
@@ -232,13 +461,80 @@ class Exchange
             }
         }
 
-        std::vector<std::pair<double, std::size_t>> get_market_depth(const std::string& _ticker, OrderSide _side, std::size_t depth = 10) const
+        double get_tick_size(const std::string& _ticker) const
+        {
+            return get_tick_size(StockExchange.id_of(_ticker));
+        }
+
+        // Price of one Tick, converts the tick prices of OrderInfo, TopOfBook and AuctionQuote (-1 if the stock does not exist)
+        double get_tick_size(SymbolId _symbol) const
         {
             try
             {
-                if (StockExchange.find(_ticker) == StockExchange.end()) 
-                    throw std::runtime_error("Stock Does Not Exist");
-                return StockExchange.at(_ticker)->get_market_depth(_side, depth);
+                auto engine = listed(_symbol);
+                return engine->get_tick_size();
+            }
+            catch(const std::exception& e)
+            {
+                if (verbose)
+                    std::cerr << "Get Tick Size Error: " << e.what() << '\n';
+                return -1;
+            }
+        }
+
+        double get_lot_size(const std::string& _ticker) const
+        {
+            return get_lot_size(StockExchange.id_of(_ticker));
+        }
+
+        // Quantity of one Lot, converts the lot quantities of OrderInfo, TopOfBook and AuctionQuote (-1 if the stock does not exist)
+        double get_lot_size(SymbolId _symbol) const
+        {
+            try
+            {
+                auto engine = listed(_symbol);
+                return engine->get_lot_size();
+            }
+            catch(const std::exception& e)
+            {
+                if (verbose)
+                    std::cerr << "Get Lot Size Error: " << e.what() << '\n';
+                return -1;
+            }
+        }
+
+        std::size_t get_order_count(const std::string& _ticker, OrderStatus status) const
+        {
+            return get_order_count(StockExchange.id_of(_ticker), status);
+        }
+
+        // O(1) count of orders in a status, see OrderEngine::get_order_count (0 if the stock does not exist)
+        std::size_t get_order_count(SymbolId _symbol, OrderStatus status) const
+        {
+            try
+            {
+                auto engine = listed(_symbol);
+                return engine->get_order_count(status);
+            }
+            catch(const std::exception& e)
+            {
+                if (verbose)
+                    std::cerr << "Get Order Count Error: " << e.what() << '\n';
+                return 0;
+            }
+        }
+
+        std::vector<std::pair<double, double>> get_market_depth(const std::string& _ticker, OrderSide _side, std::size_t depth = 10) const
+        {
+            return get_market_depth(StockExchange.id_of(_ticker), _side, depth);
+        }
+
+        std::vector<std::pair<double, double>> get_market_depth(SymbolId _symbol, OrderSide _side, std::size_t depth = 10) const
+        {
+            try
+            {
+                auto engine = listed(_symbol);
+                return engine->get_market_depth(_side, depth);
             }
             catch(const std::exception& e)
             {
@@ -248,23 +544,379 @@ class Exchange
             }
         }
 
+        std::optional<EngineStats> get_stats(const std::string& _ticker) const
+        {
+            return get_stats(StockExchange.id_of(_ticker));
+        }
+
+        // Engine counters and latency percentiles, read while the engine keeps trading
+        std::optional<EngineStats> get_stats(SymbolId _symbol) const
+        {
+            try
+            {
+                auto engine = listed(_symbol);
+                return engine->get_stats();
+            }
+            catch(const std::exception& e)
+            {
+                if (verbose)
+                    std::cerr << "Get Stats Error: " << e.what() << '\n';
+                return std::nullopt;
+            }
+        }
+
+        // Stats for every listed Stock
+        std::vector<std::pair<std::string, EngineStats>> get_all_stats() const
+        {
+            std::vector<std::pair<std::string, EngineStats>> stats;
+            StockExchange.for_each([&](const std::string& ticker, const std::shared_ptr<OrderEngine>& engine)
+            {
+                stats.emplace_back(ticker, engine->get_stats());
+            });
+            return stats;
+        }
+
+        // Batch Order Entry: groups requests by ticker and hands each engine its group in one shot,
+        // engines work their groups in parallel. Acks line up with _requests (id 0 / REJECTED if refused here)
+        std::vector<OrderAck> submit_batch(std::span<const OrderRequest> _requests) const
+        {
+            std::vector<OrderAck> acks(_requests.size(), OrderAck{0, OrderStatus::REJECTED});
+            std::vector<std::pair<OrderEngines::Ref, std::vector<std::size_t>>> groups; // Engine -> Request Indices
+            std::unordered_map<std::string_view, std::size_t> group_of; // Ticker -> Group (npos if unlisted)
+            constexpr std::size_t NO_GROUP = static_cast<std::size_t>(-1);
+            std::string_view last_ticker;
+            std::size_t last_group = NO_GROUP;
+            std::size_t accepted = 0;
+
+            for (std::size_t i = 0; i < _requests.size(); ++i)
+            {
+                const OrderRequest& request = _requests[i];
+                // If price (limit) or qty less than or equal to 0
+                if (request.qty <= 0 || (request.type == OrderType::LIMIT && request.price <= 0))
+                {
+                    if (verbose)
+                        std::cerr << "Batch Order Error: Price/Quantity must be > 0 (request " << i << ")\n";
+                    continue;
+                }
+
+                // Resolve the group, bursts for one ticker skip the hash lookup
+                if (last_group == NO_GROUP || request.ticker != last_ticker)
+                {
+                    auto found = group_of.find(request.ticker);
+                    if (found == group_of.end())
+                    {
+                        auto engine = StockExchange.find(request.ticker);
+                        const std::size_t group = engine ? groups.size() : NO_GROUP;
+                        if (group != NO_GROUP)
+                            groups.emplace_back(std::move(engine), std::vector<std::size_t>());
+                        found = group_of.emplace(request.ticker, group).first;
+                    }
+                    last_ticker = request.ticker;
+                    last_group = found->second;
+                }
+                if (last_group == NO_GROUP)
+                {
+                    if (verbose)
+                        std::cerr << "Batch Order Error: Stock Does Not Exist (request " << i << ")\n";
+                    continue;
+                }
+                groups[last_group].second.push_back(i);
+                ++accepted;
+            }
+
+            // One hand-off and wakeup per engine, one wait for the whole batch
+            AckLatch latch(accepted);
+            for (auto& [engine, which] : groups)
+                engine->submit_batch(_requests, which, acks, latch);
+            if (accepted)
+                latch.wait();
+            return acks;
+        }
+
+        // Combo Order (multi-leg, across tickers), all-or-none
+        // Every leg fills completely at once or nothing trades. The leg engines are held together (in Symbol ID order,
+        // so concurrent combos cannot deadlock), each leg is priced against its book, and only when all of them fill -
+        // within _net_limit if given - are the legs traded back to back on the calling thread. No other order reaches
+        // those books in between, and no leg waits on another engine's round trip
+        ComboResult combo_order(std::span<const OrderRequest> _legs, std::optional<double> _net_limit = std::nullopt) const
+        {
+            ComboResult result;
+            result.legs.assign(_legs.size(), OrderAck{0, OrderStatus::REJECTED});
+            try
+            {
+                // If no legs
+                if (_legs.empty())
+                    throw std::runtime_error("Combo Needs at Least One Leg");
+
+                // Resolve every leg before holding anything
+                std::vector<std::pair<SymbolId, std::size_t>> order; // Symbol ID -> Leg, the hold order
+                std::vector<OrderEngines::Ref> engines(_legs.size());
+                for (std::size_t i = 0; i < _legs.size(); ++i)
+                {
+                    const OrderRequest& leg = _legs[i];
+                    // If price (limit) or qty less than or equal to 0
+                    if (leg.qty <= 0 || (leg.type == OrderType::LIMIT && leg.price <= 0))
+                        throw std::runtime_error("Price/Quantity must be > 0");
+                    const SymbolId symbol = StockExchange.id_of(leg.ticker);
+                    engines[i] = listed(symbol);
+                    order.emplace_back(symbol, i);
+                }
+                std::sort(order.begin(), order.end());
+                for (std::size_t i = 1; i < order.size(); ++i)
+                    if (order[i].first == order[i - 1].first)
+                        throw std::runtime_error("Combo Legs Must Be Different Stocks");
+
+                // Released in reverse on every way out
+                struct Holds
+                {
+                    std::vector<OrderEngine*> engines;
+                    ~Holds()
+                    {
+                        for (auto engine = engines.rbegin(); engine != engines.rend(); ++engine)
+                            (*engine)->release();
+                    }
+                } holds;
+                for (const auto& [symbol, i] : order)
+                {
+                    engines[i]->hold();
+                    holds.engines.push_back(engines[i].get());
+                }
+
+                // Price every leg, a single one that would not fill completely sinks the combo
+                std::vector<double> fill_prices(_legs.size());
+                for (std::size_t i = 0; i < _legs.size(); ++i)
+                {
+                    const OrderRequest& leg = _legs[i];
+                    auto price = engines[i]->quote_fill(leg.side, leg.type, leg.price, leg.qty);
+                    // If the leg would not fill in full
+                    if (!price)
+                        throw std::runtime_error("Combo Leg Cannot Fill (" + leg.ticker + ")");
+                    fill_prices[i] = *price;
+                    result.net_price += (leg.side == OrderSide::BID ? 1.0 : -1.0) * *price * leg.qty;
+                }
+                // If the net price is through the limit
+                if (_net_limit && result.net_price > *_net_limit)
+                    throw std::runtime_error("Combo Net Price Outside Limit");
+
+                // Trade each leg at its quoted level
+                for (std::size_t i = 0; i < _legs.size(); ++i)
+                    result.legs[i] = engines[i]->execute(_legs[i].side, OrderType::LIMIT, fill_prices[i], _legs[i].qty);
+                result.filled = true;
+                return result;
+            }
+            catch(const std::exception& e)
+            {
+                if (verbose)
+                    std::cerr << "Combo Order Error: " << e.what() << '\n';
+                return result;
+            }
+        }
+
+        // Snapshot every Stock to _directory/<ticker>.snap, books are copied one by one and written in parallel
+        bool checkpoint(const std::string& _directory) const
+        {
+            try
+            {
+                std::filesystem::create_directories(_directory);
+                std::vector<std::pair<std::string, std::future<bool>>> writes;
+                StockExchange.for_each([&](const std::string& ticker, const std::shared_ptr<OrderEngine>& engine)
+                {
+                    writes.emplace_back(ticker, engine->save_snapshot((std::filesystem::path(_directory) / (ticker + ".snap")).string()));
+                });
+
+                bool saved = true;
+                for (auto& [ticker, write] : writes)
+                {
+                    if (!write.get())
+                    {
+                        saved = false;
+                        if (verbose)
+                            std::cerr << "Checkpoint Error: Failed to Snapshot " << ticker << '\n';
+                    }
+                }
+                return saved;
+            }
+            catch(const std::exception& e)
+            {
+                if (verbose)
+                    std::cerr << "Checkpoint Error: " << e.what() << '\n';
+                return false;
+            }
+        }
+
+        // Restore every Stock with a <ticker>.snap in _directory (replaying <ticker>.journal on top if present),
+        // engines load in parallel. Returns how many Stocks were listed
+        std::size_t warm_start(const std::string& _directory, const EngineConfig& _config = EngineConfig())
+        {
+            try
+            {
+                // If called from a scheduler worker (a pooled engine's callback), it would wait on itself
+                if (Scheduler->on_worker())
+                    throw std::runtime_error("Called From A Scheduler Worker");
+                std::vector<std::pair<std::string, std::future<std::shared_ptr<OrderEngine>>>> loads;
+                for (const auto& entry : std::filesystem::directory_iterator(_directory))
+                {
+                    if (entry.path().extension() != ".snap")
+                        continue;
+                    const std::string ticker = entry.path().stem().string();
+                    // If ticker is already in Exchange then skip
+                    if (StockExchange.contains(ticker))
+                        continue;
+
+                    BookSnapshot snapshot;
+                    if (!snapshot.open(entry.path().string()))
+                    {
+                        if (verbose)
+                            std::cerr << "Warm Start Error: Unreadable Snapshot " << entry.path() << '\n';
+                        continue;
+                    }
+                    EngineConfig config = _config;
+                    config.tick_size = snapshot.header().tick_size;
+                    config.lot_size = snapshot.header().lot_size;
+                    config.snapshot_path = entry.path().string();
+                    const auto journal = std::filesystem::path(_directory) / (ticker + ".journal");
+                    config.journal_path = std::filesystem::exists(journal) ? journal.string() : std::string();
+                    config.pooled = pooled(config);
+                    loads.emplace_back(ticker, std::async(std::launch::async, [this, ticker, config]
+                    {
+                        return std::make_shared<OrderEngine>(ticker, verbose, config);
+                    }));
+                }
+
+                std::size_t listed = 0;
+                for (auto& [ticker, load] : loads)
+                {
+                    auto engine = load.get();
+                    if (!engine->get_recovered())
+                    {
+                        if (verbose)
+                            std::cerr << "Warm Start Error: Failed to Restore " << ticker << '\n';
+                        continue;
+                    }
+                    if (pooled(_config))
+                        Scheduler->attach(engine, ticker);
+                    if (!StockExchange.insert(ticker, engine))
+                    {
+                        Scheduler->detach(engine, false);
+                        if (verbose)
+                            std::cerr << "Warm Start Error: Stock Already Exist " << ticker << '\n';
+                        continue;
+                    }
+                    ++listed;
+                }
+                return listed;
+            }
+            catch(const std::exception& e)
+            {
+                if (verbose)
+                    std::cerr << "Warm Start Error: " << e.what() << '\n';
+                return 0;
+            }
+        }
+
+        // Rebalance engines across scheduler workers by recent load, returns how many moved
+        std::size_t rebalance()
+        {
+            try
+            {
+                return Scheduler->rebalance();
+            }
+            catch(const std::exception& e)
+            {
+                if (verbose)
+                    std::cerr << "Rebalance Error: " << e.what() << '\n';
+                return 0;
+            }
+        }
+
+        // Move a Stock's engine to a specific scheduler worker (isolate a hot symbol)
+        bool assign_worker(const std::string& _ticker, std::size_t _worker)
+        {
+            return assign_worker(StockExchange.id_of(_ticker), _worker);
+        }
+
+        bool assign_worker(SymbolId _symbol, std::size_t _worker)
+        {
+            try
+            {
+                auto engine = StockExchange.share(_symbol);
+                // If ticker is not in Exchange then error
+                if (!engine)
+                    throw std::runtime_error("Stock Does Not Exist");
+                if (!Scheduler->assign(engine, _worker))
+                    throw std::runtime_error("Worker Does Not Exist");
+                return true;
+            }
+            catch(const std::exception& e)
+            {
+                if (verbose)
+                    std::cerr << "Assign Worker Error: " << e.what() << '\n';
+                return false;
+            }
+        }
+
+        // Remove a Stock from the Exchange. Routing stops at once, orders already in flight finish on the engine
+        bool delist_stock(const std::string& _ticker)
+        {
+            try
+            {
+                // Checked before delisting: if called from a scheduler worker (a pooled engine's callback), it would wait on itself
+                if (Scheduler->on_worker())
+                    throw std::runtime_error("Called From A Scheduler Worker");
+                auto engine = StockExchange.erase(_ticker);
+                // If ticker is not in Exchange then error
+                if (!engine)
+                    throw std::runtime_error("Stock Does Not Exist");
+                // Engines still shared (get_engine holders) keep draining on their own thread
+                Scheduler->detach(engine, engine.use_count() > 1);
+                return true;
+            }
+            catch(const std::exception& e)
+            {
+                if (verbose)
+                    std::cerr << "Delist Stock Error: " << e.what() << '\n';
+                return false;
+            }
+        }
+
+        // GET: Symbol ID of a listed Stock (0 if not listed), resolve once and trade through the handle
+        SymbolId get_symbol_id(const std::string& _ticker) const
+        {
+            return StockExchange.id_of(_ticker);
+        }
+
+        // GET: Is a Symbol ID listed under this Ticker (checks a resolved handle with one lookup and no hashing)
+        bool is_listed_as(SymbolId _symbol, std::string_view _ticker) const
+        {
+            auto engine = StockExchange.find(_symbol);
+            return engine && engine->get_ticker() == _ticker;
+        }
+
         std::vector<std::string> get_tradable_tickers() const
         {
             std::vector<std::string> tickers;
             // Itterate Through All Stocks in Exchange
-            for (auto& stock: StockExchange)
-                tickers.push_back(stock.first);
-            return std::move(tickers);
+            StockExchange.for_each([&](const std::string& ticker, const std::shared_ptr<OrderEngine>&)
+            {
+                tickers.push_back(ticker);
+            });
+            return tickers;
         }
         
         std::shared_ptr<OrderEngine> get_engine(const std::string& _ticker) const
+        {
+            return get_engine(StockExchange.id_of(_ticker));
+        }
+
+        std::shared_ptr<OrderEngine> get_engine(SymbolId _symbol) const
         {
             try
             {
-                 // If ticker is not in Exchange then error
-                if (StockExchange.find(_ticker) == StockExchange.end())
+                auto engine = StockExchange.share(_symbol);
+                // If ticker is not in Exchange then error
+                if (!engine)
                     throw std::runtime_error("Stock Does Not Exist");
-                return StockExchange.at(_ticker);
+                return engine;
             }
             catch(const std::exception& e)
             {
@@ -276,6 +928,22 @@ class Exchange
         }
 
     private:
+        // Is an Engine drained by the scheduler. One pinned to a core or idling other than BLOCKING keeps its own thread
+        static bool pooled(const EngineConfig& _config)
+        {
+            return _config.engine_core < 0 && _config.wait_strategy == WaitStrategy::BLOCKING;
+        }
+
+        // Engine listed under a Symbol ID, throws if there is none. Delisting waits for the returned pin to go
+        OrderEngines::Ref listed(SymbolId _symbol) const
+        {
+            auto engine = StockExchange.find(_symbol);
+            if (!engine)
+                throw std::runtime_error("Stock Does Not Exist");
+            return engine;
+        }
+
+        std::unique_ptr<EngineScheduler> Scheduler; // Worker threads shared by every engine
         OrderEngines StockExchange;
         bool verbose; // Verbose Mode
 };
\ No newline at end of file
@@ -0,0 +1,68 @@
+#include "OrderGateway.cpp"
+#include <csignal>
+
+// Build: g++ -std=c++20 -O2 -pthread GatewayServer.cpp -o gateway
+// Usage: gateway <port> [--list TICKER [IPO PRICE] [IPO QTY]]... [--route FIRST_TICKER HOST:PORT]...
+//   Shard:  gateway 9001 --list TSLA --list ZM
+//   Front:  gateway 9000 --list AAPL --route M 127.0.0.1:9001
+
+static std::atomic<bool> interrupted{false};
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <port> [--list TICKER [IPO PRICE] [IPO QTY]]... [--route FIRST_TICKER HOST:PORT]..." << std::endl;
+        return 1;
+    }
+
+    Exchange exchange(false);
+    GatewayConfig config;
+    config.port = std::uint16_t(std::stoul(argv[1]));
+    for (int i = 2; i < argc; ++i)
+    {
+        const std::string flag = argv[i];
+        if (flag == "--list" && i + 1 < argc)
+        {
+            const std::string ticker = argv[++i];
+            double ipo_price = 100.0;
+            double ipo_qty = 10000;
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+                ipo_price = std::stod(argv[++i]);
+            if (i + 1 < argc && argv[i + 1][0] != '-')
+                ipo_qty = std::stod(argv[++i]);
+            if (!exchange.initialize_stock(ticker, ipo_price, ipo_qty))
+                return 1;
+        }
+        else if (flag == "--route" && i + 2 < argc)
+        {
+            const std::string first_ticker = argv[++i];
+            const std::string endpoint = argv[++i];
+            const std::size_t colon = endpoint.rfind(':');
+            if (colon == std::string::npos)
+            {
+                std::cerr << "Route endpoint must be HOST:PORT, got " << endpoint << std::endl;
+                return 1;
+            }
+            config.routes.push_back(ShardRoute{first_ticker, endpoint.substr(0, colon), std::uint16_t(std::stoul(endpoint.substr(colon + 1)))});
+        }
+        else
+        {
+            std::cerr << "Unknown argument " << flag << std::endl;
+            return 1;
+        }
+    }
+
+    OrderGateway gateway(&exchange, config);
+    if (!gateway.start())
+        return 1;
+    std::cout << "GATEWAY LISTENING ON " << gateway.get_port() << " (" << exchange.get_tradable_tickers().size() << " LOCAL TICKERS, " << config.routes.size() << " ROUTES)" << std::endl;
+
+    // Serve until interrupted
+    std::signal(SIGINT, [](int) { interrupted = true; });
+    std::signal(SIGTERM, [](int) { interrupted = true; });
+    while (!interrupted)
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    gateway.stop();
+    return 0;
+}
@@ -0,0 +1,125 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Open-Addressing ID Table
+// Flat linear-probing map keyed by order ID with backward-shift deletion, so inserts and erases never
+// allocate unless the table has to grow. ID 0 is reserved as the empty marker (Order IDs start at 1)
+template <typename V>
+class IdMap
+{
+public:
+    IdMap(const std::size_t _capacity = 1024)
+    : count(0)
+    {
+        rehash(_capacity);
+    }
+
+    // Find Value by ID (nullptr if absent)
+    V* find(const unsigned int key)
+    {
+        if (!key)
+            return nullptr; // Reserved empty marker
+        for (std::size_t i = home(key);; i = (i + 1) & mask)
+        {
+            if (slots[i].key == key) return &slots[i].value;
+            if (!slots[i].key) return nullptr;
+        }
+    }
+
+    const V* find(const unsigned int key) const
+    {
+        return const_cast<IdMap*>(this)->find(key);
+    }
+
+    // Insert or Assign
+    void insert(const unsigned int key, const V& value)
+    {
+        if ((count + 1) * 2 > slots.size())
+            rehash(slots.size()); // Keep load factor at or below 1/2
+        std::size_t i = home(key);
+        while (slots[i].key && slots[i].key != key)
+            i = (i + 1) & mask;
+        if (!slots[i].key)
+            ++count;
+        slots[i] = {key, value};
+    }
+
+    // Erase by ID
+    bool erase(const unsigned int key)
+    {
+        if (!key)
+            return false; // Reserved empty marker
+        std::size_t i = home(key);
+        while (slots[i].key != key)
+        {
+            if (!slots[i].key) return false;
+            i = (i + 1) & mask;
+        }
+
+        // Shift back any entries whose probe sequence ran through the hole
+        for (std::size_t j = (i + 1) & mask; slots[j].key; j = (j + 1) & mask)
+        {
+            const std::size_t k = home(slots[j].key);
+            const bool in_range = i <= j ? (i < k && k <= j) : (i < k || k <= j);
+            if (in_range) continue;
+            slots[i] = slots[j];
+            i = j;
+        }
+        slots[i].key = 0;
+        --count;
+        return true;
+    }
+
+    // Visit every (ID, Value)
+    template <typename Fn>
+    void for_each(Fn&& fn) const
+    {
+        for (const auto& slot : slots)
+        {
+            if (slot.key) fn(slot.key, slot.value);
+        }
+    }
+
+    std::size_t size() const { return count; }
+
+private:
+    struct Slot
+    {
+        unsigned int key;
+        V value;
+    };
+
+    std::vector<Slot> slots;
+    std::size_t mask;
+    int shift;
+    std::size_t count;
+
+    // Fibonacci hashing spreads sequential IDs across the table
+    std::size_t home(const unsigned int key) const
+    {
+        return (std::uint64_t(key) * 11400714819323198485ull) >> shift;
+    }
+
+    void rehash(const std::size_t _capacity)
+    {
+        std::size_t size = 16;
+        int bits = 4;
+        while (size < _capacity * 2)
+        {
+            size <<= 1;
+            ++bits;
+        }
+
+        std::vector<Slot> old = std::move(slots);
+        slots.assign(size, Slot{0, V{}});
+        mask = size - 1;
+        shift = 64 - bits;
+        count = 0;
+        for (const auto& slot : old)
+        {
+            if (slot.key) insert(slot.key, slot.value);
+        }
+    }
+};
@@ -0,0 +1,170 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <bit>
+#include <thread>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// Monotonic Timestamp in Nanoseconds (steady_clock, comparable across threads)
+inline std::int64_t now_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Cheapest Monotonic Timestamp: the TSC on x86 (invariant, so comparable across cores on current parts),
+// steady_clock nanoseconds elsewhere. Convert tick deltas with ns_per_tick()
+inline std::uint64_t now_ticks()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::uint64_t(now_ns());
+#endif
+}
+
+// Tick/Clock pair taken at start-up, the baseline for calibrating ticks against steady_clock
+struct TickBase
+{
+    std::int64_t ns = now_ns();
+    std::uint64_t ticks = now_ticks();
+};
+inline const TickBase tick_base;
+
+// Nanoseconds per now_ticks() tick, measured over the process lifetime so far (at least 1ms)
+inline double ns_per_tick()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    std::int64_t elapsed = now_ns() - tick_base.ns;
+    while (elapsed < 1000000)
+    {
+        std::this_thread::yield(); // Called right at start-up, wait for a usable baseline
+        elapsed = now_ns() - tick_base.ns;
+    }
+    const std::uint64_t ticks = now_ticks() - tick_base.ticks;
+    return ticks ? double(elapsed) / double(ticks) : 1.0;
+#else
+    return 1.0;
+#endif
+}
+
+// Histogram Percentiles (in the units the summary was scaled to)
+struct LatencySummary
+{
+    std::uint64_t count = 0;
+    double mean = 0;
+    std::uint64_t p50 = 0;
+    std::uint64_t p90 = 0;
+    std::uint64_t p99 = 0;
+    std::uint64_t p999 = 0;
+    std::uint64_t max = 0;
+};
+
+// Single-Writer HDR-Style Histogram
+// Log-linear buckets: exact below 32, then 32 sub-buckets per power of two (under 3.2% relative error) up to 2^40.
+// The owning thread records with relaxed atomic stores, so any thread can summarise it while it keeps recording
+class LatencyHistogram
+{
+public:
+    LatencyHistogram()
+    : total(0), sum(0), largest(0)
+    {
+        for (auto& bucket : buckets)
+            bucket.store(0, std::memory_order_relaxed);
+    }
+
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    // Record a Value (owning thread only, negative values count as 0)
+    void record(const std::int64_t _value)
+    {
+        const std::uint64_t value = _value > 0 ? std::uint64_t(_value) : 0;
+        bump(buckets[index_of(value)], 1);
+        bump(total, 1);
+        bump(sum, value);
+        if (value > largest.load(std::memory_order_relaxed))
+            largest.store(value, std::memory_order_relaxed);
+    }
+
+    // Summarise (any thread), values multiplied by _scale (ns_per_tick() for tick deltas).
+    // Concurrent records may land in some fields and not yet others
+    LatencySummary summary(const double _scale = 1.0) const
+    {
+        LatencySummary result;
+        std::uint64_t counts[BUCKETS];
+        for (std::size_t i = 0; i < BUCKETS; ++i)
+        {
+            counts[i] = buckets[i].load(std::memory_order_relaxed);
+            result.count += counts[i];
+        }
+        if (!result.count)
+            return result;
+        const std::uint64_t max = largest.load(std::memory_order_relaxed);
+        auto scaled = [_scale](const std::uint64_t _value) { return std::uint64_t(double(_value) * _scale + 0.5); };
+        result.mean = double(sum.load(std::memory_order_relaxed)) / double(result.count) * _scale;
+        result.max = scaled(max);
+        result.p50 = scaled(percentile(counts, result.count, 0.50, max));
+        result.p90 = scaled(percentile(counts, result.count, 0.90, max));
+        result.p99 = scaled(percentile(counts, result.count, 0.99, max));
+        result.p999 = scaled(percentile(counts, result.count, 0.999, max));
+        return result;
+    }
+
+    std::uint64_t count() const { return total.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr unsigned SUB_BITS = 5;
+    static constexpr std::uint64_t SUB_COUNT = 1ull << SUB_BITS; // Sub-buckets per power of two
+    static constexpr unsigned MAX_BITS = 40; // Values at or above 2^40 land in the last bucket
+    static constexpr std::size_t BUCKETS = (MAX_BITS - SUB_BITS + 1) * SUB_COUNT;
+
+    std::atomic<std::uint64_t> buckets[BUCKETS];
+    std::atomic<std::uint64_t> total;
+    std::atomic<std::uint64_t> sum;
+    std::atomic<std::uint64_t> largest;
+
+    // Single writer, so a relaxed load and store stands in for a locked add
+    static void bump(std::atomic<std::uint64_t>& counter, const std::uint64_t _by)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + _by, std::memory_order_relaxed);
+    }
+
+    static std::size_t index_of(const std::uint64_t _value)
+    {
+        if (_value < SUB_COUNT)
+            return _value;
+        const unsigned msb = 63 - std::countl_zero(_value);
+        if (msb >= MAX_BITS)
+            return BUCKETS - 1;
+        const unsigned shift = msb - SUB_BITS;
+        return (shift + 1) * SUB_COUNT + ((_value >> shift) - SUB_COUNT);
+    }
+
+    // Highest value that falls in a bucket
+    static std::uint64_t value_of(const std::size_t _index)
+    {
+        if (_index < SUB_COUNT)
+            return _index;
+        const unsigned shift = unsigned(_index / SUB_COUNT) - 1;
+        const std::uint64_t sub = _index % SUB_COUNT + SUB_COUNT;
+        return ((sub + 1) << shift) - 1;
+    }
+
+    static std::uint64_t percentile(const std::uint64_t* counts, const std::uint64_t _count, const double _quantile, const std::uint64_t _max)
+    {
+        const std::uint64_t rank = std::max<std::uint64_t>(1, std::uint64_t(_quantile * double(_count) + 0.5));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < BUCKETS; ++i)
+        {
+            seen += counts[i];
+            if (seen >= rank)
+                return std::min(value_of(i), _max);
+        }
+        return _max;
+    }
+};
@@ -0,0 +1,105 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdio>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Read-Only Memory-Mapped File
+// Maps a whole file so fixed-size records can be used in place. Falls back to reading the file into memory
+// where mmap is unavailable
+class MappedFile
+{
+public:
+    MappedFile()
+    : bytes(nullptr), length(0)
+    {
+    }
+
+    ~MappedFile()
+    {
+        close();
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Map a File, false if it cannot be opened or is empty
+    bool open(const std::string& _path)
+    {
+        close();
+#if defined(__unix__) || defined(__APPLE__)
+        const int fd = ::open(_path.c_str(), O_RDONLY);
+        if (fd < 0)
+            return false;
+        struct stat info;
+        if (::fstat(fd, &info) || info.st_size <= 0)
+        {
+            ::close(fd);
+            return false;
+        }
+        void* mapped = ::mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd); // The mapping keeps the file alive
+        if (mapped == MAP_FAILED)
+            return false;
+        bytes = static_cast<const std::byte*>(mapped);
+        length = info.st_size;
+        return true;
+#else
+        FILE* file = std::fopen(_path.c_str(), "rb");
+        if (!file)
+            return false;
+        std::fseek(file, 0, SEEK_END);
+        const long size = std::ftell(file);
+        std::fseek(file, 0, SEEK_SET);
+        if (size > 0)
+        {
+            fallback.resize(size);
+            if (std::fread(fallback.data(), 1, size, file) == std::size_t(size))
+            {
+                bytes = fallback.data();
+                length = size;
+            }
+        }
+        std::fclose(file);
+        return length;
+#endif
+    }
+
+    void close()
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        if (bytes)
+            ::munmap(const_cast<std::byte*>(bytes), length);
+#endif
+        fallback.clear();
+        bytes = nullptr;
+        length = 0;
+    }
+
+    const std::byte* data() const { return bytes; }
+
+    std::size_t size() const { return length; }
+
+private:
+    const std::byte* bytes;
+    std::size_t length;
+    std::vector<std::byte> fallback; // File contents when mmap is unavailable
+};
+
+// Push a flushed FILE to stable storage
+inline void sync_file(FILE* file)
+{
+#if defined(__linux__)
+    ::fdatasync(::fileno(file));
+#elif defined(__unix__) || defined(__APPLE__)
+    ::fsync(::fileno(file));
+#else
+    (void)file;
+#endif
+}
@@ -1,14 +1,20 @@
-#include "Exchange.cpp"
+#include "OrderFlow.cpp"
+#include <cinttypes>
 
 // Print engine stats for a specific ticker
 void print_stats(const std::string& ticker, const std::shared_ptr<OrderEngine>& engine) 
 {
     std::cout << "=== STATS FOR " << ticker << " ===" << std::endl;
     std::cout << "CURRENT PRICE: " << engine->get_price() << std::endl;
-    std::cout << "OPEN ORDERS COUNT: " << engine->get_orders_by_status(OrderStatus::OPEN).size() << std::endl;
-    std::cout << "FILLED ORDERS COUNT: " << engine->get_orders_by_status(OrderStatus::FILLED).size() << std::endl;
-    std::cout << "CANCELED ORDERS COUNT: " << engine->get_orders_by_status(OrderStatus::CANCELLED).size() << std::endl;
-    std::cout << "REJECTED ORDERS COUNT: " << engine->get_orders_by_status(OrderStatus::REJECTED).size() << std::endl;
+    std::cout << "OPEN ORDERS COUNT: " << engine->get_order_count(OrderStatus::OPEN) << std::endl;
+    std::cout << "FILLED ORDERS COUNT: " << engine->get_order_count(OrderStatus::FILLED) << std::endl;
+    std::cout << "CANCELED ORDERS COUNT: " << engine->get_order_count(OrderStatus::CANCELLED) << std::endl;
+    std::cout << "REJECTED ORDERS COUNT: " << engine->get_order_count(OrderStatus::REJECTED) << std::endl;
+    const EngineStats stats = engine->get_stats();
+    std::cout << "ORDERS/SEC: " << stats.orders_per_second << " FILLS/SEC: " << stats.fills_per_second << std::endl;
+    std::cout << "LATENCY (ns) p50/p99/max: QUEUE " << stats.queue.p50 << "/" << stats.queue.p99 << "/" << stats.queue.max <<
+    " MATCH " << stats.match.p50 << "/" << stats.match.p99 << "/" << stats.match.max <<
+    " TOTAL " << stats.total.p50 << "/" << stats.total.p99 << "/" << stats.total.max << std::endl;
     std::cout << "=== MARKET DEPTH BIDS ===" << std::endl;
     auto bids_depth = engine->get_market_depth(OrderSide::BID, 20);
     for (auto& order: bids_depth)
@@ -21,69 +27,70 @@ void print_stats(const std::string& ticker, const std::shared_ptr<OrderEngine>&
 }
 
 
-// Monte Carlo Simulation for a single ticker with skew support
-void monte_carlo_simulation
-(const std::shared_ptr<Exchange>& StockExchange, const std::string& ticker, int num_orders, double ipo_price, 
- double ipo_qty, double volatility, double skew) // skew: -1.0 (bearish) to 1.0 (bullish)
+// Replay a Flow through a fresh Exchange, print the run and each book, and check the digest against _expected (0 skips)
+int run(const OrderFlow& flow, double rate, std::uint64_t expected)
 {
-    StockExchange->initialize_stock(ticker, ipo_price, ipo_qty);
-    std::mt19937_64 rng(std::random_device{}());
-
-    std::normal_distribution<double> normal_dist(0.0, volatility);
-    std::uniform_real_distribution<double> qty_dist(1, 100);
-    std::uniform_real_distribution<double> offset_dist(-5, 5);
-    std::bernoulli_distribution side_bias(0.5 + skew * 0.5); // skew biases toward BUY if >0
-
-    double cancel_probability = 0.05;
-    std::uniform_real_distribution<double> cancel_chance(0.0, 1.0);
-
-    for (int i = 0; i < num_orders; ++i) {
-        // Bias order side using skew
-        OrderSide side = side_bias(rng) ? OrderSide::BID : OrderSide::ASK;
-        OrderType type = (rng() % 2 == 0) ? OrderType::MARKET : OrderType::LIMIT;
-        double qty = qty_dist(rng);
-
-        // Apply skewed price change
-        double current_price = StockExchange->get_price(ticker);
-        double change = normal_dist(rng);
-
-        // Apply skew to upward vs downward moves
-        if (change > 0) change *= (1.0 + skew); // upward amplified if bullish
-        else change *= (1.0 - skew);            // downward dampened if bullish
-
-        double price = current_price != -1 ? std::max(0.01, current_price * (1.0 + change) + offset_dist(rng)) : ipo_price;
-
-        unsigned int order_id;
-        if (type == OrderType::MARKET)
-            order_id = StockExchange->market_order(ticker, side, qty);
-        else
-            order_id = StockExchange->limit_order(ticker, side, price, qty);
+    Exchange exchange(false);
+    const ReplayResult result = replay_flow(exchange, flow, rate);
+    if (!result.completed)
+    {
+        std::cerr << "Replay failed to list the flow's tickers" << std::endl;
+        return 1;
+    }
 
-        if (cancel_chance(rng) < cancel_probability)
-            StockExchange->cancel_order(ticker, order_id);
+    for (const auto& ticker : flow.tickers)
+    {
+        print_stats(ticker, exchange.get_engine(ticker));
+        std::cout << std::endl;
+    }
+    std::printf("REPLAYED %zu RECORDS (%zu REJECTED) IN %.3fs: %.0f RECORDS/SEC\n", result.records, result.rejected, result.seconds, result.records_per_second);
+    std::printf("DIGEST: %016" PRIx64 "\n", result.digest);
+    if (expected && expected != result.digest)
+    {
+        std::printf("DIGEST MISMATCH: expected %016" PRIx64 "\n", expected);
+        return 1;
     }
+    return 0;
 }
-// Main function to spawn threads for multiple tickers
-int main() 
+
+// Usage:
+//   MonteCarloSim                                              generate the default flow in memory and replay it
+//   MonteCarloSim generate <flow file> [orders per ticker] [seed]
+//   MonteCarloSim replay <flow file> [records/sec, 0 = unthrottled] [expected digest (hex)]
+int main(int argc, char** argv) 
 {
-    std::shared_ptr<Exchange> DBSE = std::make_shared<Exchange>(false);
-    std::vector<std::string> tickers = {"AAPL", "TSLA", "AMZN", "NVDA"};
-    std::vector<std::thread> threads;
+    const std::string mode = argc > 1 ? argv[1] : "";
+    if (mode.empty())
+        return run(generate_flow(FlowConfig()), 0, 0);
 
-    for (const auto& ticker : tickers) {
-        threads.emplace_back([=]() {
-            monte_carlo_simulation(DBSE, ticker, 10000, 100.0, 10000, 0.05, 0.15);
-        });
+    if (mode == "generate" && argc > 2)
+    {
+        FlowConfig config;
+        if (argc > 3)
+            config.orders_per_ticker = std::stoull(argv[3]);
+        if (argc > 4)
+            config.seed = std::stoull(argv[4]);
+        const OrderFlow flow = generate_flow(config);
+        if (!flow.save(argv[2]))
+        {
+            std::cerr << "Failed to write " << argv[2] << std::endl;
+            return 1;
+        }
+        std::cout << "WROTE " << flow.records.size() << " RECORDS TO " << argv[2] << std::endl;
+        return 0;
     }
 
-    for (auto& t : threads) {
-        t.join(); // Wait for all simulations to finish
+    if (mode == "replay" && argc > 2)
+    {
+        OrderFlow flow;
+        if (!flow.load(argv[2]))
+        {
+            std::cerr << "Failed to read " << argv[2] << std::endl;
+            return 1;
+        }
+        return run(flow, argc > 3 ? std::stod(argv[3]) : 0, argc > 4 ? std::stoull(argv[4], nullptr, 16) : 0);
     }
 
-    // Print stats after all threads finish
-    for (const auto& ticker : tickers) {
-        print_stats(ticker, DBSE->get_engine(ticker)); // Assumes Exchange::get_engine(ticker) exists
-        std::cout << std::endl;
-    }
-    return 0;
+    std::cerr << "Usage: " << argv[0] << " [generate <flow> [orders per ticker] [seed] | replay <flow> [records/sec] [digest]]" << std::endl;
+    return 1;
 }
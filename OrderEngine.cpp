@@ -1,13 +1,39 @@
 #pragma once
 #include "PriceHeap.cpp"
+#include "SlabPool.cpp"
+#include "IdMap.cpp"
+#include "OrderHistory.cpp"
+#include "RingBuffer.cpp"
+#include "WaitStrategy.cpp"
+#include "EventStream.cpp"
+#include "Seqlock.cpp"
+#include "MappedFile.cpp"
+#include "LatencyHistogram.cpp"
 #include <memory>
-#include <deque>
 #include <random>
 #include <thread>
 #include <mutex>
+#include <condition_variable>
 #include <atomic>
+#include <unordered_map>
+#include <string>
+#include <ctime>
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <set>
 #include <map>
+#include <vector>
+#include <optional>
+#include <functional>
+#include <iostream>
+#include <future>
+#include <span>
+#include <numeric>
+#include <filesystem>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
 
 // Order Status
 enum class OrderStatus
@@ -32,530 +58,2014 @@ enum class OrderSide
     ASK
 };
 
+// Side an Order trades against
+constexpr OrderSide opposite(const OrderSide _side)
+{
+    return _side == OrderSide::BID ? OrderSide::ASK : OrderSide::BID;
+}
+
+struct OrderLevel;
+
 // Order Info
 struct OrderInfo
 {
     const OrderSide side;
     const OrderType type;
     OrderStatus status;
-    double qty;
-    double price;
     const unsigned int id;
+    std::int64_t qty; // Quantity in Lots
+    std::int64_t price; // Price in Ticks
     const std::time_t time;
+
+    // Level Position
+    OrderLevel* level; // Level the order rests on
+    std::uint32_t slot; // Index of the order's slot in that level
+
+    std::uint32_t account; // Risk account the order was entered for (0 if none)
     
-    OrderInfo(const OrderSide _side, const OrderType _type, double _qty, double _price, const unsigned int _id) 
-    : side(_side), type(_type), status(OrderStatus::OPEN), qty(_qty), price(_price), id(_id), time(std::time(nullptr))
+    OrderInfo(const OrderSide _side, const OrderType _type, std::int64_t _qty, std::int64_t _price, const unsigned int _id, const std::time_t _time = std::time(nullptr), const std::uint32_t _account = 0) 
+    : side(_side), type(_type), status(OrderStatus::OPEN), id(_id), qty(_qty), price(_price), time(_time),
+      level(nullptr), slot(0), account(_account)
+    {
+    }
+};
+
+// Price Level Slot
+// The hot part of a resting order, packed four to a cache line: the lots a sweep fills against and the cold record
+struct LevelSlot
+{
+    std::int64_t qty; // Lots left on the order, kept equal to order->qty (0 once the slot is empty)
+    OrderInfo* order; // Order record (nullptr once the slot is empty)
+};
+
+// Price Level
+// FIFO of resting orders in one contiguous slot array, oldest first, so a sweep streams the array instead of
+// chasing links through the order records. Cancels empty their slot in O(1); empty slots are compacted away
+// once they outnumber the live ones. Keeps a running quantity and order count so depth queries never walk the orders
+struct OrderLevel
+{
+    std::vector<LevelSlot> slots; // Resting Orders in time priority, empty slots included
+    std::size_t head = 0; // First live slot (while the level is not empty)
+    std::int64_t total_qty = 0; // Lots resting on the level
+    std::size_t count = 0; // Orders resting on the level
+
+    bool empty() const { return !count; }
+
+    OrderInfo* front() const { return count ? slots[head].order : nullptr; }
+
+    LevelSlot& front_slot() { return slots[head]; }
+
+    // Enqueue at the back of the level (time priority)
+    void push_back(OrderInfo* order)
+    {
+        if (slots.size() - count >= std::max<std::size_t>(count, MIN_COMPACT))
+            compact();
+        order->level = this;
+        order->slot = std::uint32_t(slots.size());
+        slots.push_back(LevelSlot{order->qty, order});
+        total_qty += order->qty;
+        ++count;
+    }
+
+    // Remove from anywhere in the level
+    void erase(OrderInfo* order)
+    {
+        remove(order);
+        if (slots.size() - count >= std::max<std::size_t>(count, MIN_COMPACT))
+            compact();
+    }
+
+    // Remove the oldest order (never compacts, so a sweep can keep going)
+    void pop_front() { remove(slots[head].order); }
+
+    // Take quantity off a resting order (fills)
+    void reduce(OrderInfo* order, const std::int64_t _qty)
+    {
+        slots[order->slot].qty -= _qty;
+        order->qty -= _qty;
+        total_qty -= _qty;
+    }
+
+    // Visit Resting Orders in time priority
+    template <typename Fn>
+    void for_each(Fn&& fn) const
+    {
+        for (std::size_t i = head; i < slots.size(); ++i)
+            if (slots[i].order)
+                fn(slots[i].order);
+    }
+
+private:
+    static constexpr std::size_t MIN_COMPACT = 8; // Empty slots tolerated before compacting a small level
+
+    void remove(OrderInfo* order)
+    {
+        LevelSlot& slot = slots[order->slot];
+        total_qty -= slot.qty;
+        slot = LevelSlot{0, nullptr};
+        order->level = nullptr;
+        if (!--count)
+        {
+            slots.clear(); // Keeps the capacity for the next order
+            head = 0;
+            return;
+        }
+        while (!slots[head].order)
+            ++head;
+    }
+
+    // Close up the empty slots, renumbering the orders that move
+    void compact()
+    {
+        std::size_t out = 0;
+        for (std::size_t i = head; i < slots.size(); ++i)
+        {
+            if (!slots[i].order)
+                continue;
+            slots[out] = slots[i];
+            slots[out].order->slot = std::uint32_t(out);
+            ++out;
+        }
+        slots.resize(out);
+        head = 0;
+    }
+};
+
+// Engine Configuration
+struct EngineConfig
+{
+    double tick_size = 0.01; // Minimum Price Increment
+    double lot_size = 1.0; // Minimum Quantity Increment (the book holds whole lots)
+    std::size_t history_capacity = 4096; // Retired Orders kept answerable by get_order (0 disables), grown into as orders retire
+    std::size_t ingress_capacity = 1024; // Commands the submit ring holds before submitters back off (allocated up front, raise for hot symbols)
+    WaitStrategy wait_strategy = WaitStrategy::BLOCKING; // How the engine thread idles between commands (anything else keeps an Exchange engine off the scheduler)
+    int engine_core = -1; // CPU core to pin the engine thread to (-1 leaves it to the OS; set, an Exchange engine keeps its own thread)
+    std::size_t report_capacity = 1024; // Execution reports buffered for the report consumer (the engine backs off while it is full)
+    std::size_t market_data_capacity = 1024; // L2 book updates buffered for the market data consumer (the engine backs off while it is full)
+    std::size_t snapshot_interval = 4096; // Book updates between full L2 snapshots (0 disables periodic snapshots)
+    std::string journal_path; // Write-ahead journal of applied commands, replayed on construction (empty disables)
+    bool journal_fsync = true; // Sync the journal to disk once per group commit
+    std::size_t journal_capacity = 65536; // Journal entries buffered for the journal writer (only allocated with a journal_path)
+    std::string snapshot_path; // Book snapshot loaded on construction before the journal replays (empty disables)
+    bool pooled = false; // Drained by an EngineScheduler worker instead of a dedicated thread (Exchange decides from the two above)
+    bool collect_stats = true; // Timestamp commands through the engine into latency histograms
+    bool auction = false; // Start in an auction call, orders rest without matching until uncross()
+};
+
+// Command Types
+enum class CommandType
+{
+    NEW,
+    CANCEL,
+    AMEND,
+    SNAPSHOT,
+    AUCTION, // Open an auction call
+    UNCROSS // Cross the auction and resume continuous matching
+};
+
+// Order Acknowledgement
+struct OrderAck
+{
+    unsigned int id; // Order ID
+    OrderStatus status; // Status once the engine processed the command (REJECTED if refused)
+};
+
+using AckCallback = std::function<void(const OrderAck&)>;
+
+// Batch Order Request
+struct OrderRequest
+{
+    std::string ticker; // Routing key for Exchange::submit_batch (OrderEngine ignores it)
+    OrderSide side;
+    OrderType type;
+    double price; // Limit Price (ignored for market orders)
+    double qty;
+};
+
+// Blocking Acknowledgement Latch
+// Lives on the waiting thread's stack. The engine notifies while holding the latch's lock,
+// so the waiter cannot return and destroy it while the engine is still touching it
+struct AckLatch
+{
+    std::mutex lock;
+    std::condition_variable cv;
+    std::size_t remaining;
+
+    AckLatch(const std::size_t _count)
+    : remaining(_count)
+    {
+    }
+
+    void count_down()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!--remaining)
+            cv.notify_all();
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        cv.wait(guard, [this]{ return !remaining; });
+    }
+};
+
+// Execution Report Types
+enum class ReportType : std::uint8_t
+{
+    OPEN,
+    PARTIAL_FILL,
+    FILL,
+    CANCEL,
+    REJECT,
+    AMEND // Price or quantity changed, qty holds the quantity before the amend and leaves the new one
+};
+
+// Reject Reasons
+enum class RejectReason : std::uint8_t
+{
+    NONE,
+    PRICE_BELOW_TICK,
+    NO_LIQUIDITY_BIDS,
+    NO_LIQUIDITY_ASKS,
+    QTY_BELOW_LOT,
+    MARKET_IN_AUCTION,
+    QTY_NOT_LOT_MULTIPLE,
+    PRICE_NOT_TICK_MULTIPLE
+};
+
+inline const char* to_string(const RejectReason _reason)
+{
+    switch (_reason)
+    {
+        case RejectReason::NONE: return "NONE";
+        case RejectReason::PRICE_BELOW_TICK: return "PRICE BELOW ONE TICK";
+        case RejectReason::NO_LIQUIDITY_BIDS: return "NO MARKET LIQUIDITY (BIDS)";
+        case RejectReason::NO_LIQUIDITY_ASKS: return "NO MARKET LIQUIDITY (ASKS)";
+        case RejectReason::QTY_BELOW_LOT: return "QUANTITY BELOW ONE LOT";
+        case RejectReason::MARKET_IN_AUCTION: return "MARKET ORDER DURING AUCTION";
+        case RejectReason::QTY_NOT_LOT_MULTIPLE: return "QUANTITY NOT A WHOLE NUMBER OF LOTS";
+        case RejectReason::PRICE_NOT_TICK_MULTIPLE: return "PRICE NOT A WHOLE NUMBER OF TICKS";
+    }
+    return "UNKNOWN";
+}
+
+// Execution Report (fixed-size binary record)
+struct ExecutionReport
+{
+    std::uint64_t seq; // Per-engine sequence number
+    std::time_t time; // Event Time
+    std::int64_t price; // Price in Ticks
+    std::int64_t qty; // Event Quantity in Lots (fill size for fills, order size otherwise)
+    std::int64_t leaves; // Lots left on the order afterwards
+    unsigned int id; // Order ID
+    ReportType type;
+    OrderSide side;
+    OrderType order_type;
+    RejectReason reason;
+    std::uint32_t account; // Risk account of the order (0 if none)
+};
+
+// Top of Book Snapshot (published by the engine after every book change)
+struct TopOfBook
+{
+    std::int64_t bid; // Best Bid in Ticks (-1 if the side is empty)
+    std::int64_t ask; // Best Ask in Ticks (-1 if the side is empty)
+    std::int64_t bid_qty; // Lots resting at the best bid
+    std::int64_t ask_qty; // Lots resting at the best ask
+    std::int64_t last_price; // Last Trade Price in Ticks (-1 before the first trade)
+    std::int64_t last_qty; // Last Trade Quantity in Lots
+    std::uint64_t seq; // Snapshot Sequence Number (counts book changes)
+};
+
+// Auction Uncross (equilibrium of a crossed book)
+struct AuctionQuote
+{
+    std::int64_t price; // Uncross Price in Ticks (-1 if the book does not cross)
+    std::int64_t qty; // Lots that trade at the price
+    std::int64_t imbalance; // Crossing bid lots minus crossing ask lots at the price (the surplus left resting)
+};
+
+// Engine Statistics (cumulative since construction, readable while the engine trades)
+struct EngineStats
+{
+    double uptime = 0; // Seconds since the engine started
+    std::uint64_t commands = 0; // Commands processed
+    std::uint64_t orders = 0; // New orders accepted
+    std::uint64_t fills = 0; // Trades
+    std::uint64_t cancels = 0; // Cancels accepted
+    std::uint64_t amends = 0; // Amends accepted
+    std::uint64_t rejects = 0; // Commands refused
+    double orders_per_second = 0; // Average over the uptime
+    double fills_per_second = 0; // Average over the uptime
+    LatencySummary queue; // Submit to engine dequeue (ns)
+    LatencySummary match; // Dequeue to matching complete (ns)
+    LatencySummary publish; // Matching complete to top of book and L2 published (ns)
+    LatencySummary total; // Submit to published (ns)
+};
+
+// L2 Book Update Actions
+enum class BookAction : std::uint8_t
+{
+    ADD, // New price level
+    MODIFY, // Quantity or order count changed on a level
+    DELETE, // Price level emptied
+    SNAPSHOT_BEGIN, // Full book follows (count holds the number of levels)
+    SNAPSHOT_LEVEL, // One level of the full book, bids then asks, best first
+    SNAPSHOT_END // Full book complete, deltas resume after this sequence number
+};
+
+// L2 Book Update (fixed-size binary record)
+// Sequence numbers are gapless per engine, a consumer that misses one discards its copy and rebuilds from the next snapshot
+struct BookUpdate
+{
+    std::uint64_t seq; // Per-engine Market Data Sequence Number
+    std::int64_t price; // Price in Ticks
+    std::int64_t qty; // Lots resting on the level afterwards (0 for DELETE)
+    std::uint32_t count; // Orders resting on the level afterwards
+    OrderSide side;
+    BookAction action;
+};
+
+// Journal Entry (fixed-size binary record of a command the book applied)
+struct JournalEntry
+{
+    std::uint64_t seq; // Per-engine Journal Sequence Number
+    std::time_t time; // Order Time given to new orders
+    std::int64_t price; // Price in Ticks
+    std::int64_t qty; // Quantity in Lots
+    unsigned int id; // Order ID, or target Order ID for cancel/amend
+    std::uint32_t account; // Risk account of new orders (0 if none)
+    CommandType type;
+    OrderSide side;
+    OrderType order_type;
+};
+
+// Book Snapshot File
+// SnapshotHeader | SnapshotLevel[bid_levels] | SnapshotLevel[ask_levels] | SnapshotOrder[orders]
+// Levels run best first and own orders[first, first + count) in FIFO order, so a mapped file is used in place
+struct SnapshotHeader
+{
+    char magic[8]; // BookSnapshot::MAGIC
+    std::uint32_t version;
+    unsigned int next_order_id; // Next Order ID to hand out
+    std::uint64_t journal_seq; // Last journal entry the snapshot covers
+    double tick_size;
+    double lot_size;
+    std::int64_t last_trade_price; // Last Trade Price in Ticks (-1 before the first trade)
+    std::int64_t last_trade_qty; // Last Trade Quantity in Lots
+    std::uint64_t bid_levels;
+    std::uint64_t ask_levels;
+    std::uint64_t orders;
+    std::uint64_t auction; // 1 if an auction call was open
+};
+
+struct SnapshotLevel
+{
+    std::int64_t price; // Price in Ticks
+    std::int64_t qty; // Lots resting on the level
+    std::uint64_t first; // Index of the level's oldest order
+    std::uint64_t count; // Orders resting on the level
+};
+
+struct SnapshotOrder
+{
+    std::int64_t price; // Price in Ticks
+    std::int64_t qty; // Remaining Lots
+    std::time_t time;
+    unsigned int id;
+    std::uint32_t account; // Risk account (0 if none)
+    OrderSide side;
+    OrderType type;
+};
+
+// Memory-Mapped Book Snapshot (read side)
+class BookSnapshot
+{
+public:
+    static constexpr char MAGIC[8] = "OBSNAP1";
+    static constexpr std::uint32_t VERSION = 4; // 2: quantities in lots, 3: auction state, 4: order accounts
+
+    // Map a Snapshot, false if missing, foreign or truncated
+    bool open(const std::string& _path)
+    {
+        if (!file.open(_path) || file.size() < sizeof(SnapshotHeader))
+            return false;
+        const SnapshotHeader& head = header();
+        if (std::memcmp(head.magic, MAGIC, sizeof(MAGIC)) || head.version != VERSION)
+            return false;
+        return file.size() == sizeof(SnapshotHeader) + (head.bid_levels + head.ask_levels) * sizeof(SnapshotLevel) + head.orders * sizeof(SnapshotOrder);
+    }
+
+    const SnapshotHeader& header() const { return *reinterpret_cast<const SnapshotHeader*>(file.data()); }
+
+    std::span<const SnapshotLevel> bids() const { return {levels(), header().bid_levels}; }
+
+    std::span<const SnapshotLevel> asks() const { return {levels() + header().bid_levels, header().ask_levels}; }
+
+    std::span<const SnapshotOrder> orders() const 
+    { 
+        return {reinterpret_cast<const SnapshotOrder*>(levels() + header().bid_levels + header().ask_levels), header().orders}; 
+    }
+
+private:
+    MappedFile file;
+
+    const SnapshotLevel* levels() const { return reinterpret_cast<const SnapshotLevel*>(file.data() + sizeof(SnapshotHeader)); }
+};
+
+// Engine Command
+struct OrderCommand
+{
+    CommandType type;
+    OrderSide side;
+    OrderType order_type;
+    unsigned int id; // New Order ID, or target Order ID for cancel/amend
+    std::int64_t price; // Price in Ticks
+    std::int64_t qty; // Quantity in Lots
+    AckCallback on_ack; // Fired on the engine thread, keep it cheap
+    std::uint64_t submitted = 0; // now_ticks() at enqueue (0 if not stamped)
+    std::uint32_t account = 0; // Risk account for new orders (0 if none)
+};
+
+// Aliases
+using LevelMap = std::unordered_map<std::int64_t, OrderLevel>;
+using OrderMap = IdMap<OrderInfo*>;
+
+// Order Matching Engine
+class OrderEngine
+{
+public:
+    // Default Constructor
+    OrderEngine(const std::string& _ticker, const EngineConfig& _config = EngineConfig()) 
+    : History(_config.history_capacity), recent_order_id(0), next_order_id(1), Ingress(_config.ingress_capacity), engine_running(true), waker(&Signal), draining(false), commands_processed(0), wait_strategy(_config.wait_strategy), engine_core(_config.engine_core), Reports(_config.report_capacity), report_seq(0), Top(TopOfBook{-1, -1, 0, 0, -1, 0, 0}), top{-1, -1, 0, 0, -1, 0, 0}, last_trade_price(-1), last_trade_qty(0), MarketData(_config.market_data_capacity), market_data_seq(0), updates_since_snapshot(0), snapshot_interval(_config.snapshot_interval), Journal(_config.journal_capacity), journal_seq(0), replayed(0), replaying(false), recovered(false), vebose(true), ticker(_ticker), tick_size(_config.tick_size), lot_size(_config.lot_size), collect_stats(_config.collect_stats), started_ns(now_ns()), orders_accepted(0), fills(0), cancels(0), amends(0), rejects(0), StatusCounts{}, auction(_config.auction), last_auction{-1, 0, 0}
+    {
+        Reports.subscribe([this](const ExecutionReport& _report) { print_report(_report); });
+        recovered = load_snapshot(_config);
+        open_journal(_config);
+        if (!_config.pooled)
+            engine = std::thread(&OrderEngine::matching_engine, this);
+    } 
+
+    // Verbose Specifier
+    OrderEngine(const std::string& _ticker, bool _verbose, const EngineConfig& _config = EngineConfig()) 
+    : History(_config.history_capacity), recent_order_id(0), next_order_id(1), Ingress(_config.ingress_capacity), engine_running(true), waker(&Signal), draining(false), commands_processed(0), wait_strategy(_config.wait_strategy), engine_core(_config.engine_core), Reports(_config.report_capacity), report_seq(0), Top(TopOfBook{-1, -1, 0, 0, -1, 0, 0}), top{-1, -1, 0, 0, -1, 0, 0}, last_trade_price(-1), last_trade_qty(0), MarketData(_config.market_data_capacity), market_data_seq(0), updates_since_snapshot(0), snapshot_interval(_config.snapshot_interval), Journal(_config.journal_capacity), journal_seq(0), replayed(0), replaying(false), recovered(false), vebose(_verbose), ticker(_ticker), tick_size(_config.tick_size), lot_size(_config.lot_size), collect_stats(_config.collect_stats), started_ns(now_ns()), orders_accepted(0), fills(0), cancels(0), amends(0), rejects(0), StatusCounts{}, auction(_config.auction), last_auction{-1, 0, 0}
+    {
+        if (vebose)
+            Reports.subscribe([this](const ExecutionReport& _report) { print_report(_report); });
+        recovered = load_snapshot(_config);
+        open_journal(_config);
+        if (!_config.pooled)
+            engine = std::thread(&OrderEngine::matching_engine, this);
+    } 
+   
+    ~OrderEngine()
+    {
+        engine_running = false;
+        Signal.notify_all();
+        if (engine.joinable()) 
+            engine.join(); // Engine drains queued commands before exiting
+        else
+            while (poll()); // Pooled engine (already detached from its scheduler), drain here
+        Reports.stop(); // Deliver the reports it published
+        MarketData.stop(); // Deliver the book updates it published
+        Journal.stop(); // Commit the journal tail
+    }
+
+    // Drain one batch on the calling thread (scheduler workers), false if there was nothing to do
+    // or another thread is draining. The try-lock hands the consumer side of the queue between threads
+    bool poll()
+    {
+        if (draining.exchange(true, std::memory_order_acquire))
+            return false;
+        const bool drained = drain();
+        draining.store(false, std::memory_order_release);
+        return drained;
+    }
+
+    // Are Commands waiting to be drained
+    bool has_work() const { return Ingress.pending(); }
+
+    // Exclusive Hold (combo orders)
+    // Takes the drain role from the engine's thread or worker and applies a batch queued ahead of the caller,
+    // then nothing else trades the book until release(). Callers holding several engines take them in one global order
+    void hold()
+    {
+        while (draining.exchange(true, std::memory_order_acquire))
+            cpu_relax();
+        drain();
+    }
+
+    void release()
+    {
+        draining.store(false, std::memory_order_release);
+        if (Ingress.pending())
+            wake(); // Commands that queued behind the hold
+    }
+
+    // Price an order would fill the whole of _qty at right now, nullopt if it would not fill completely at once
+    // (crossing prices clamp to the opposing best, so fills stop at that level). Stable while held
+    std::optional<double> quote_fill(const OrderSide _side, const OrderType _type, double _limit_price, double _qty) const
+    {
+        std::unique_lock<std::mutex> lock(order_lock);
+        const std::int64_t qty = to_lots(_qty);
+        auto quote = [&](const auto& book, const LevelMap& levels) -> std::optional<double>
+        {
+            if (auction.load(std::memory_order_relaxed) || !book.size() || qty <= 0)
+                return std::nullopt; // Nothing fills at once during an auction call
+            const std::int64_t best = book.peek();
+            // If Limit Price is off the tick grid or does not reach the opposing best
+            const std::int64_t limit = to_ticks(_limit_price);
+            if (_type == OrderType::LIMIT && (limit == OFF_TICK || book.better(limit, best)))
+                return std::nullopt;
+            if (levels.at(best).total_qty < qty)
+                return std::nullopt;
+            return to_price(best);
+        };
+        return _side == OrderSide::BID ? quote(AsksBook, AskLevels) : quote(BidsBook, BidLevels);
+    }
+
+    // Apply a New Order on the calling thread while held, exactly as the engine would (journaled, published, counted)
+    OrderAck execute(const OrderSide _side, const OrderType _type, double _limit_price, double _qty)
+    {
+        const OrderCommand cmd{CommandType::NEW, _side, _type, next_order_id.fetch_add(1), to_ticks(_limit_price), to_lots(_qty), nullptr};
+        OrderAck ack{cmd.id, OrderStatus::REJECTED};
+        {
+            std::unique_lock<std::mutex> lock(order_lock);
+            ack = process(cmd);
+            publish_top();
+            publish_book_updates();
+            count(cmd, ack);
+        }
+        commands_processed.fetch_add(1, std::memory_order_relaxed);
+        Reports.notify();
+        MarketData.notify();
+        Journal.notify();
+        return ack;
+    }
+
+    // Route wakeups to a scheduler worker (pooled engines)
+    void attach(WakeSignal* _waker)
+    {
+        waker.store(_waker);
+    }
+
+    // Leave the scheduler and drain on a dedicated thread from now on
+    void detach()
+    {
+        waker.store(&Signal);
+        if (!engine.joinable())
+            engine = std::thread(&OrderEngine::matching_engine, this);
+    }
+
+    // GET: Commands processed so far (scheduler load measure)
+    std::uint64_t get_commands_processed() const { return commands_processed.load(std::memory_order_relaxed); }
+
+    // Subscribe to Execution Reports (callback runs on the report consumer thread), returns a handle for unsubscribe_reports
+    std::uint64_t subscribe_reports(std::function<void(const ExecutionReport&)> _subscriber)
+    {
+        return Reports.subscribe(std::move(_subscriber));
+    }
+
+    // Stop a Report Subscriber, which is not called again once this returns (never call it from a subscriber)
+    void unsubscribe_reports(const std::uint64_t _handle)
+    {
+        Reports.unsubscribe(_handle);
+    }
+
+    // Append Execution Reports to a binary file of ExecutionReport records
+    bool record_reports(const std::string& _path)
+    {
+        return Reports.record_to(_path);
+    }
+
+    // Subscribe to L2 Book Updates (callback runs on the market data consumer thread), returns a handle for
+    // unsubscribe_market_data. A snapshot is requested right away so the subscriber can build its book
+    std::uint64_t subscribe_market_data(std::function<void(const BookUpdate&)> _subscriber)
+    {
+        const std::uint64_t handle = MarketData.subscribe(std::move(_subscriber));
+        request_snapshot();
+        return handle;
+    }
+
+    // Stop a Market Data Subscriber, which is not called again once this returns (never call it from a subscriber)
+    void unsubscribe_market_data(const std::uint64_t _handle)
+    {
+        MarketData.unsubscribe(_handle);
+    }
+
+    // Append L2 Book Updates to a binary file of BookUpdate records
+    bool record_market_data(const std::string& _path)
+    {
+        if (!MarketData.record_to(_path))
+            return false;
+        request_snapshot();
+        return true;
+    }
+
+    // ASYNC POST: Ask the engine for a full L2 snapshot (gap recovery)
+    void request_snapshot()
+    {
+        submit(OrderCommand{CommandType::SNAPSHOT, OrderSide::BID, OrderType::LIMIT, 0, 0, 0, nullptr});
+    }
+
+    // ASYNC POST: Submit Order
+    // Returns the ID the order will carry without waiting for the engine, on_ack fires on the engine thread once processed
+    unsigned int submit_order(const OrderSide _side, const OrderType _type, double _limit_price, double _qty, AckCallback _on_ack = nullptr)
+    {
+        const unsigned int _id = next_order_id.fetch_add(1); // New Order ID
+        submit(OrderCommand{CommandType::NEW, _side, _type, _id, to_ticks(_limit_price), to_lots(_qty), std::move(_on_ack)});
+        return _id;
+    }
+
+    // Take the ID of an Order ahead of enqueue_order, so a stage can track it before any report about it can arrive
+    unsigned int reserve_order_id()
+    {
+        return next_order_id.fetch_add(1); // New Order ID
+    }
+
+    // ASYNC POST: Queue an Order entered for a risk account under a reserved ID without waking the engine (pipelined
+    // pre-trade stages hand over a run of orders, then flush() once). The account comes back on the order's execution reports
+    void enqueue_order(const unsigned int _id, const std::uint32_t _account, const OrderSide _side, const OrderType _type, double _limit_price, double _qty, AckCallback _on_ack = nullptr)
+    {
+        OrderCommand cmd{CommandType::NEW, _side, _type, _id, to_ticks(_limit_price), to_lots(_qty), std::move(_on_ack)};
+        cmd.account = _account;
+        enqueue(std::move(cmd));
+    }
+
+    // ASYNC POST: Queue a Cancel without waking the engine, see enqueue_order
+    void enqueue_cancel(const unsigned int _id, AckCallback _on_ack = nullptr)
+    {
+        enqueue(OrderCommand{CommandType::CANCEL, OrderSide::BID, OrderType::LIMIT, _id, 0, 0, std::move(_on_ack)});
+    }
+
+    // ASYNC PATCH: Queue an Amend without waking the engine, see enqueue_order
+    void enqueue_amend(const unsigned int _id, double _limit_price, double _qty, AckCallback _on_ack = nullptr)
+    {
+        enqueue(OrderCommand{CommandType::AMEND, OrderSide::BID, OrderType::LIMIT, _id, to_ticks(_limit_price), to_lots(_qty), std::move(_on_ack)});
+    }
+
+    // Wake the engine for everything queued since the last wake
+    void flush()
+    {
+        wake();
+    }
+
+    // ASYNC POST: Submit Cancel
+    void submit_cancel(const unsigned int _id, AckCallback _on_ack = nullptr)
+    {
+        submit(OrderCommand{CommandType::CANCEL, OrderSide::BID, OrderType::LIMIT, _id, 0, 0, std::move(_on_ack)});
+    }
+
+    // ASYNC PATCH: Submit Amend (the order keeps its ID, see edit_order)
+    void submit_amend(const unsigned int _id, double _limit_price, double _qty, AckCallback _on_ack = nullptr)
+    {
+        submit(OrderCommand{CommandType::AMEND, OrderSide::BID, OrderType::LIMIT, _id, to_ticks(_limit_price), to_lots(_qty), std::move(_on_ack)});
+    }
+
+    // ASYNC POST: Submit Order, acknowledged through a future
+    std::future<OrderAck> submit_order_async(const OrderSide _side, const OrderType _type, double _limit_price, double _qty)
+    {
+        auto ack = std::make_shared<std::promise<OrderAck>>();
+        std::future<OrderAck> result = ack->get_future();
+        submit_order(_side, _type, _limit_price, _qty, [ack](const OrderAck& _ack) { ack->set_value(_ack); });
+        return result;
+    }
+
+    // POST: Place Order (blocks until the engine has processed it)
+    unsigned int place_order(const OrderSide _side, const OrderType _type, double _limit_price, double _qty)
+    {
+        const unsigned int _id = next_order_id.fetch_add(1); // New Order ID
+        const OrderAck ack = await(OrderCommand{CommandType::NEW, _side, _type, _id, to_ticks(_limit_price), to_lots(_qty), nullptr});
+        return ack.status == OrderStatus::REJECTED ? 0 : ack.id; // Return Order ID
+    }
+
+    // POST: Cancel Order
+    bool cancel_order(const unsigned int _id)
+    {
+        const OrderAck ack = await(OrderCommand{CommandType::CANCEL, OrderSide::BID, OrderType::LIMIT, _id, 0, 0, nullptr});
+        return ack.status == OrderStatus::CANCELLED; // Order successfully canceled
+    }
+
+    // PATCH: Edit Order
+    // Amends a resting limit order in place and keeps its ID. Reducing quantity at the same price keeps time priority,
+    // a new price or a larger quantity sends it to the back of its (new) level, where it may trade straight away
+    unsigned int edit_order(const unsigned int _id, const double _price, const double _qty)
+    {
+        const OrderAck ack = await(OrderCommand{CommandType::AMEND, OrderSide::BID, OrderType::LIMIT, _id, to_ticks(_price), to_lots(_qty), nullptr});
+        return ack.status == OrderStatus::REJECTED ? 0 : ack.id; // Return Order ID
+    }
+
+    // ASYNC POST: Submit Batch
+    // Queues _requests[i] for every i in _which back to back and wakes the engine once. Each ack lands in _acks[i]
+    // and counts _latch down, so a single latch can span batches handed to several engines
+    void submit_batch(std::span<const OrderRequest> _requests, std::span<const std::size_t> _which, std::span<OrderAck> _acks, AckLatch& _latch)
+    {
+        for (const std::size_t i : _which)
+        {
+            const OrderRequest& request = _requests[i];
+            OrderAck* ack = &_acks[i];
+            const unsigned int _id = next_order_id.fetch_add(1); // New Order ID
+            *ack = {_id, OrderStatus::REJECTED};
+            enqueue(OrderCommand{CommandType::NEW, request.side, request.type, _id, to_ticks(request.price), to_lots(request.qty), 
+                [ack, &_latch](const OrderAck& _ack) 
+                { 
+                    *ack = _ack; 
+                    _latch.count_down(); 
+                }});
+        }
+        wake();
+    }
+
+    // POST: Place Batch (blocks until every order is acknowledged), acks line up with _requests
+    std::vector<OrderAck> place_batch(std::span<const OrderRequest> _requests)
+    {
+        std::vector<OrderAck> acks(_requests.size());
+        std::vector<std::size_t> which(_requests.size());
+        std::iota(which.begin(), which.end(), 0);
+        AckLatch latch(_requests.size());
+        submit_batch(_requests, which, acks, latch);
+        latch.wait();
+        return acks;
+    }
+
+    // POST: Open an Auction Call (blocks until applied), false if one is already open
+    // Limit orders then rest without matching, so the book may cross, and market orders are rejected until uncross()
+    bool start_auction()
+    {
+        const OrderAck ack = await(OrderCommand{CommandType::AUCTION, OrderSide::BID, OrderType::LIMIT, 0, 0, 0, nullptr});
+        return ack.status != OrderStatus::REJECTED;
+    }
+
+    // POST: Uncross the Auction (blocks until applied), nullopt if no call was open
+    // Every crossing order trades in one pass at a single price - most volume, then least imbalance, then nearest
+    // the last trade - the surplus rests and continuous matching resumes
+    std::optional<AuctionQuote> uncross()
+    {
+        const OrderAck ack = await(OrderCommand{CommandType::UNCROSS, OrderSide::BID, OrderType::LIMIT, 0, 0, 0, nullptr});
+        if (ack.status == OrderStatus::REJECTED)
+            return std::nullopt;
+        std::unique_lock<std::mutex> lock(order_lock);
+        return last_auction;
+    }
+
+    // GET: Indicative Uncross (what uncross() would trade right now)
+    AuctionQuote get_indicative_auction() const
+    {
+        std::unique_lock<std::mutex> lock(order_lock);
+        return equilibrium();
+    }
+
+    // GET: Is an Auction Call open
+    bool in_auction() const { return auction.load(std::memory_order_relaxed); }
+
+    // GET: Get Order (copy of the live record, or of its retired copy)
+    std::optional<OrderInfo> get_order(const unsigned int& _id) const
+    { 
+            std::unique_lock<std::mutex> lock(order_lock);
+            if (OrderInfo* const* order = OrderTable.find(_id))
+                return **order; // Resting Order
+            if (const OrderInfo* retired = History.find(_id))
+                return *retired; // Recently Retired Order
+            return std::nullopt; // Return nullopt if order not found
+    }
+
+    // GET: Top of Book (lock-free snapshot, safe from any thread)
+    TopOfBook get_top_of_book() const { return Top.load(); }
+
+    // GET: Average Price
+    double get_price() const 
+    {
+        const TopOfBook book = Top.load();
+        if (book.bid == -1 && book.ask == -1)
+            return -1; // If both books are empty
+        else if (book.bid == -1)
+            return to_price(book.ask); // If BidBook is empty
+        else if (book.ask == -1)
+            return to_price(book.bid); // If AskBook is Empty
+        return to_price(book.ask + book.bid) / 2; // Average of best ask and bid
+    }
+
+    // GET: Best Ask
+    double get_best_ask() const 
+    {
+        const std::int64_t ask = Top.load().ask;
+        return ask == -1 ? -1 : to_price(ask);
+    }
+
+    // GET: Best Bid
+    double get_best_bid() const 
+    {
+        const std::int64_t bid = Top.load().bid;
+        return bid == -1 ? -1 : to_price(bid);
+    }
+
+    // GET: Journal Entries replayed when the engine was constructed
+    std::size_t get_replayed() const { return replayed; }
+
+    // GET: Was the Book restored from a snapshot or journal
+    bool get_recovered() const { return recovered; }
+
+    // Write a Book Snapshot to _path
+    // The book is copied under order_lock, a background thread writes, syncs and renames it into place
+    std::future<bool> save_snapshot(const std::string& _path) const
+    {
+        return std::async(std::launch::async, [image = snapshot_image(), _path]
+        {
+            const std::string tmp_path = _path + ".tmp";
+            FILE* file = std::fopen(tmp_path.c_str(), "wb");
+            if (!file)
+                return false;
+            const bool written = std::fwrite(image.data(), 1, image.size(), file) == image.size() && !std::fflush(file);
+            if (written)
+                sync_file(file);
+            std::fclose(file);
+            std::error_code error;
+            if (written)
+                std::filesystem::rename(tmp_path, _path, error);
+            return written && !error;
+        });
+    }
+
+    // GET: Engine Statistics (counters and latency percentiles, safe from any thread while the engine trades)
+    EngineStats get_stats() const
+    {
+        EngineStats stats;
+        stats.uptime = double(now_ns() - started_ns) / 1e9;
+        stats.commands = get_commands_processed();
+        stats.orders = orders_accepted.load(std::memory_order_relaxed);
+        stats.fills = fills.load(std::memory_order_relaxed);
+        stats.cancels = cancels.load(std::memory_order_relaxed);
+        stats.amends = amends.load(std::memory_order_relaxed);
+        stats.rejects = rejects.load(std::memory_order_relaxed);
+        if (stats.uptime > 0)
+        {
+            stats.orders_per_second = double(stats.orders) / stats.uptime;
+            stats.fills_per_second = double(stats.fills) / stats.uptime;
+        }
+        const double scale = ns_per_tick();
+        stats.queue = QueueLatency.summary(scale);
+        stats.match = MatchLatency.summary(scale);
+        stats.publish = PublishLatency.summary(scale);
+        stats.total = TotalLatency.summary(scale);
+        return stats;
+    }
+
+    // GET: Ticker
+    const std::string& get_ticker() const { return ticker; }
+
+    // GET: Tick Size
+    double get_tick_size() const { return tick_size; }
+
+    // Ticks returned by to_ticks for a price that is not a whole number of ticks
+    static constexpr std::int64_t OFF_TICK = std::numeric_limits<std::int64_t>::min();
+
+    // Price to Ticks, OFF_TICK unless it is a whole number of ticks. Limits are never rounded (a rounded bid could trade through it)
+    std::int64_t to_ticks(const double _price) const { return whole_units(_price / tick_size, OFF_TICK); }
+
+    // Tick to Price
+    double to_price(const std::int64_t _ticks) const { return _ticks * tick_size; }
+
+    // GET: Lot Size
+    double get_lot_size() const { return lot_size; }
+
+    // Lots returned by to_lots for a quantity that is not a whole number of lots
+    static constexpr std::int64_t OFF_LOT = std::numeric_limits<std::int64_t>::min();
+
+    // Quantity to Lots, OFF_LOT unless it is a whole number of lots. Sizes are never rounded
+    std::int64_t to_lots(const double _qty) const { return whole_units(_qty / lot_size, OFF_LOT); }
+
+    // Whole number of ticks or lots (up to floating-point noise), otherwise the caller's sentinel
+    static std::int64_t whole_units(const double _units, const std::int64_t _off)
+    {
+        const double whole = std::round(_units);
+        return std::abs(_units - whole) <= 1e-9 * std::max(1.0, std::abs(whole)) ? std::int64_t(whole) : _off;
+    }
+
+    // Lot to Quantity
+    double to_qty(const std::int64_t _lots) const { return _lots * lot_size; }
+
+    // GET: Orders by Status
+    // OPEN orders come from the live table, terminal statuses only cover the retained history
+    std::vector<OrderInfo> get_orders_by_status(OrderStatus status) const 
+    {
+        std::unique_lock<std::mutex> lock(order_lock);
+        std::vector<OrderInfo> result;
+        if (status == OrderStatus::OPEN)
+        {
+            OrderTable.for_each([&](unsigned int, const OrderInfo* order)
+            {
+                result.push_back(*order);
+            });
+            return result;
+        }
+        History.for_each([&](const OrderInfo& order)
+        {
+            if (order.status == status)
+                result.push_back(order);
+        });
+        return result;
+    }
+    
+    // GET: Order Count by Status (O(1), safe from any thread while the engine trades)
+    // OPEN counts resting orders, FILLED/CANCELLED/REJECTED count every order that ended that way since start-up
+    std::size_t get_order_count(const OrderStatus _status) const
+    {
+        return StatusCounts[std::size_t(_status)].load(std::memory_order_relaxed);
+    }
+
+    // GET: Maket Depth
+    // Walks the top _depth levels best-first, each level carries its own running total
+    std::vector<std::pair<double, double>> get_market_depth(OrderSide _side, std::size_t _depth = 10) const
+    {
+        std::unique_lock<std::mutex> lock(order_lock);
+        std::vector<std::pair<double, double>> depth;
+        auto walk = [&](const auto& book, const LevelMap& levels)
+        {
+            depth.reserve(std::min<std::size_t>(_depth, book.size()));
+            for (std::int64_t price = book.peek(); price != -1 && depth.size() < _depth; price = book.next(price))
+                depth.emplace_back(to_price(price), to_qty(levels.at(price).total_qty));
+        };
+        if (_side == OrderSide::BID)
+            walk(BidsBook, BidLevels);
+        else
+            walk(AsksBook, AskLevels);
+        return depth;
+    }
+
+private:
+    static constexpr std::size_t DRAIN_BATCH = 256; // Commands processed per order_lock acquisition
+    static constexpr std::size_t SNAPSHOT_CHUNK = 256; // Snapshot levels published between market data consumer wakeups
+
+    // Order Book
+    AskHeap AsksBook; // Asks Order Book
+    BidHeap BidsBook; // Bids Order Book
+    LevelMap AskLevels; // Asks Price Levels
+    LevelMap BidLevels; // Bids Price Levels
+    SlabPool<OrderInfo> OrderPool; // Order Records
+    OrderMap OrderTable; // Map to all resting orders
+    OrderHistory<OrderInfo> History; // Bounded history of retired orders
+    unsigned int recent_order_id; // New Orders ID
+    std::atomic<unsigned int> next_order_id; // Next Order ID (claimed by submitters)
+
+    // Concurreny
+    std::thread engine;
+    MPSCRing<OrderCommand> Ingress; // Commands waiting for the engine thread
+    mutable std::mutex order_lock; // Guards the book while the engine drains a batch
+    std::atomic<bool> engine_running;
+    WakeSignal Signal; // Dedicated thread's idle handshake
+    std::atomic<WakeSignal*> waker; // Whoever drains the engine (Signal, or a scheduler worker's)
+    std::atomic<bool> draining; // Held by whichever thread is draining a batch
+    std::vector<std::pair<AckCallback, OrderAck>> Acks; // Acks fired once order_lock is released (drainer only)
+    std::atomic<std::uint64_t> commands_processed; // Load measure for scheduler rebalancing
+    const WaitStrategy wait_strategy; // Idle Strategy
+    const int engine_core; // Pinned Core (-1 if unpinned)
+
+    // Execution Reports
+    EventStream<ExecutionReport> Reports; // Binary report stream drained off the engine thread
+    std::uint64_t report_seq; // Last Report Sequence Number
+
+    // Market Data
+    Seqlock<TopOfBook> Top; // Top of Book readable without order_lock
+    TopOfBook top; // Last published snapshot (engine thread)
+    std::int64_t last_trade_price; // Last Trade Price in Ticks (-1 before the first trade)
+    std::int64_t last_trade_qty; // Last Trade Quantity in Lots
+
+    // L2 Market Data
+    struct TouchedLevel
+    {
+        OrderSide side;
+        std::int64_t price;
+        bool existed; // Level was on the book before the command
+        std::int64_t qty; // Level lots before the command
+        std::size_t count; // Level order count before the command
+    };
+    EventStream<BookUpdate> MarketData; // L2 update stream drained off the engine thread
+    std::vector<TouchedLevel> Touched; // Levels the current command changed
+    std::uint64_t market_data_seq; // Last Market Data Sequence Number
+    std::size_t updates_since_snapshot; // Book updates since the last full snapshot
+    const std::size_t snapshot_interval; // Book updates between full snapshots
+
+    // Write-Ahead Journal
+    EventStream<JournalEntry> Journal; // Applied commands, group-committed off the engine thread
+    std::uint64_t journal_seq; // Last Journal Sequence Number
+    std::size_t replayed; // Entries replayed on construction
+    bool replaying; // Silences reports and market data while the journal replays
+    bool recovered; // Book restored from a snapshot or journal on construction
+
+    bool vebose; // Verbose Mode
+    std::string ticker; // Ticker
+    const double tick_size; // Minimum Price Increment
+    const double lot_size; // Minimum Quantity Increment
+
+    // Latency Instrumentation
+    const bool collect_stats; // Timestamp commands (EngineConfig::collect_stats)
+    const std::int64_t started_ns; // Engine start (now_ns)
+    LatencyHistogram QueueLatency; // Submit to dequeue
+    LatencyHistogram MatchLatency; // Dequeue to matching complete
+    LatencyHistogram PublishLatency; // Matching complete to market data published
+    LatencyHistogram TotalLatency; // Submit to published
+    std::atomic<std::uint64_t> orders_accepted;
+    std::atomic<std::uint64_t> fills;
+    std::atomic<std::uint64_t> cancels;
+    std::atomic<std::uint64_t> amends;
+    std::atomic<std::uint64_t> rejects;
+    std::atomic<std::uint64_t> StatusCounts[4]; // Orders per OrderStatus: resting for OPEN, since start-up for the rest
+
+    // Auction Call
+    std::atomic<bool> auction; // Orders rest without matching until the uncross (written by the engine only)
+    AuctionQuote last_auction; // Outcome of the latest uncross
+
+    // Enqueue a Command and wake the engine if it is asleep
+    void submit(OrderCommand&& cmd)
+    {
+        enqueue(std::move(cmd));
+        wake();
+    }
+
+    // Enqueue a Command without waking the engine
+    void enqueue(OrderCommand&& cmd)
+    {
+        if (collect_stats)
+            cmd.submitted = now_ticks();
+        while (!Ingress.try_push(std::move(cmd)))
+        {
+            wake(); // Ring full, make sure the engine is draining
+            std::this_thread::yield();
+        }
+    }
+
+    // Wake the engine if it is asleep
+    void wake()
+    {
+        waker.load()->notify();
+    }
+
+    // Enqueue a Command and block until it is acknowledged
+    OrderAck await(OrderCommand&& cmd)
+    {
+        AckLatch latch(1);
+        OrderAck result{cmd.id, OrderStatus::REJECTED};
+        cmd.on_ack = [&latch, &result](const OrderAck& _ack) 
+        { 
+            result = _ack; 
+            latch.count_down(); 
+        };
+        submit(std::move(cmd));
+        latch.wait();
+        return result;
+    }
+
+    // Matching Engine (dedicated thread)
+    void matching_engine()
+    {
+        // Dedicated Core
+        if (engine_core >= 0 && !pin_current_thread(engine_core) && vebose)
+            std::cerr << "[" << ticker << "] Failed to pin engine thread to core " << engine_core << '\n';
+
+        while (true)
+        {
+            if (poll())
+                continue; // Keep draining while there is flow
+
+            if (!engine_running)
+                return; // Shut down once the queue is drained
+
+            // Idle until a submitter enqueues
+            switch (wait_strategy)
+            {
+                case WaitStrategy::BUSY_SPIN:
+                    cpu_relax();
+                    break;
+
+                case WaitStrategy::YIELD:
+                    std::this_thread::yield();
+                    break;
+
+                case WaitStrategy::BLOCKING:
+                    Signal.wait([this]{ 
+                            return !engine_running || Ingress.pending(); 
+                    });
+                    break;
+            }
+        }
+    }
+
+    // Drain a batch of Commands under one lock, false if the queue was empty (caller holds draining)
+    bool drain()
+    {
+        if (!Ingress.pending())
+            return false;
+
+        OrderCommand cmd;
+        std::size_t processed = 0;
+        {
+            std::unique_lock<std::mutex> lock(order_lock);
+            std::uint64_t dequeued = collect_stats ? now_ticks() : 0; // The previous command's publish time thereafter
+            for (; processed < DRAIN_BATCH && Ingress.try_pop(cmd); ++processed)
+            {
+                const OrderAck ack = process(cmd);
+                const std::uint64_t matched = collect_stats ? now_ticks() : 0;
+                publish_top();
+                publish_book_updates();
+                count(cmd, ack);
+                if (collect_stats)
+                {
+                    const std::uint64_t published = now_ticks();
+                    record_latency(cmd, dequeued, matched, published);
+                    dequeued = published;
+                }
+                if (cmd.on_ack)
+                    Acks.emplace_back(std::move(cmd.on_ack), ack);
+            }
+        }
+        commands_processed.fetch_add(processed, std::memory_order_relaxed);
+
+        Reports.notify(); // One consumer wakeup per batch
+        MarketData.notify();
+        Journal.notify(); // One group commit per batch
+        for (auto& [on_ack, ack] : Acks)
+            on_ack(ack);
+        Acks.clear();
+        return true;
+    }
+
+    // Count a processed Command by outcome
+    void count(const OrderCommand& cmd, const OrderAck& ack)
+    {
+        if (ack.status == OrderStatus::REJECTED)
+        {
+            if (cmd.type == CommandType::NEW || cmd.type == CommandType::CANCEL || cmd.type == CommandType::AMEND)
+                rejects.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        switch (cmd.type)
+        {
+            case CommandType::NEW: orders_accepted.fetch_add(1, std::memory_order_relaxed); break;
+            case CommandType::CANCEL: cancels.fetch_add(1, std::memory_order_relaxed); break;
+            case CommandType::AMEND: amends.fetch_add(1, std::memory_order_relaxed); break;
+            case CommandType::SNAPSHOT:
+            case CommandType::AUCTION:
+            case CommandType::UNCROSS: break;
+        }
+    }
+
+    // Record a Command's stage latencies (in ticks, converted when read)
+    void record_latency(const OrderCommand& cmd, const std::uint64_t _dequeued, const std::uint64_t _matched, const std::uint64_t _published)
+    {
+        if (cmd.type == CommandType::SNAPSHOT || cmd.type == CommandType::AUCTION || cmd.type == CommandType::UNCROSS)
+            return; // Not an order
+        MatchLatency.record(std::int64_t(_matched - _dequeued));
+        PublishLatency.record(std::int64_t(_published - _matched));
+        if (!cmd.submitted)
+            return; // Enqueued before stats were on
+        QueueLatency.record(std::int64_t(_dequeued - cmd.submitted)); // Submitter's core, can read a hair ahead
+        TotalLatency.record(std::int64_t(_published - cmd.submitted));
+    }
+
+    // Apply a Command to the Book, journaling it if the book accepted it
+    OrderAck process(const OrderCommand& cmd)
+    {
+        const std::time_t now = std::time(nullptr); // Order Time (journaled so replays restore it)
+        switch (cmd.type)
+        {
+            case CommandType::NEW:
+                {
+                    const OrderAck ack = process_new(cmd.side, cmd.order_type, cmd.price, cmd.qty, cmd.id, now, cmd.account);
+                    if (ack.status != OrderStatus::REJECTED)
+                        journal(cmd, now);
+                    return ack;
+                }
+
+            case CommandType::CANCEL:
+                {
+                    const OrderAck ack = process_cancel(cmd.id);
+                    if (ack.status != OrderStatus::REJECTED)
+                        journal(cmd, now);
+                    return ack;
+                }
+
+            case CommandType::SNAPSHOT:
+                publish_snapshot();
+                return {0, OrderStatus::OPEN};
+
+            case CommandType::AMEND:
+                {
+                    const OrderAck ack = process_amend(cmd.id, cmd.price, cmd.qty);
+                    if (ack.status != OrderStatus::REJECTED)
+                        journal(cmd, now);
+                    return ack;
+                }
+
+            case CommandType::AUCTION:
+                {
+                    const OrderAck ack = process_auction();
+                    if (ack.status != OrderStatus::REJECTED)
+                        journal(cmd, now);
+                    return ack;
+                }
+
+            case CommandType::UNCROSS:
+                {
+                    const OrderAck ack = process_uncross();
+                    if (ack.status != OrderStatus::REJECTED)
+                        journal(cmd, now);
+                    return ack;
+                }
+        }
+        return {cmd.id, OrderStatus::REJECTED}; // Invalid Command
+    }
+
+    // Amend Order
+    OrderAck process_amend(const unsigned int _id, std::int64_t _price, const std::int64_t _qty)
     {
+        OrderInfo* const* found = OrderTable.find(_id);
+        if (!found)
+            return {_id, OrderStatus::REJECTED}; // Order does not exist
+        
+        OrderInfo* order = *found;
+        if (order->status != OrderStatus::OPEN || order->type != OrderType::LIMIT)
+            return {_id, OrderStatus::REJECTED}; // Order is not open and not a limit order
+        if (_price <= 0 || _qty <= 0)
+            return {_id, OrderStatus::REJECTED}; // New price or qty is not > 0, or is off the tick or lot grid
+
+        // Same price and no more quantity: reduce in place and keep time priority
+        const std::int64_t previous_qty = order->qty;
+        if (_price == order->price && _qty <= order->qty)
+        {
+            if (_qty != order->qty)
+            {
+                touch(order->side, order->price);
+                order->level->reduce(order, order->qty - _qty);
+                notify_amend(order, previous_qty);
+            }
+            return {_id, OrderStatus::OPEN};
+        }
+
+        // Otherwise requeue at the back of the new level and match like a fresh order
+        unlink(order);
+        order->qty = _qty;
+        return order->side == OrderSide::BID ? requeue<OrderSide::BID>(order, _price, previous_qty) : requeue<OrderSide::ASK>(order, _price, previous_qty);
     }
-};
 
-// Aliases
-using OrderLevel = std::deque<std::shared_ptr<OrderInfo>>;
-using LevelMap = std::unordered_map<double, OrderLevel>;
-using OrderMap = std::unordered_map<unsigned int, std::shared_ptr<OrderInfo>>;
+    // Rest an unlinked Order again at a new price and match it
+    template <OrderSide SIDE>
+    OrderAck requeue(OrderInfo* order, const std::int64_t _price, const std::int64_t _previous_qty)
+    {
+        order->price = auction ? _price : marketable_price<SIDE>(_price);
+        rest<SIDE>(order);
+        notify_amend(order, _previous_qty);
+        if (auction)
+            return {order->id, OrderStatus::OPEN}; // Waits for the uncross
+        recent_order_id = order->id;
+        const OrderStatus status = match<SIDE>(order);
+        return {order->id, status};
+    }
 
-// Order Matching Engine
-class OrderEngine
-{
-public:
-    // Default Constructor
-    OrderEngine(const std::string& _ticker) 
-    : engine_running(true), book_updated(false), recent_order_id(0), next_order_id(1), AsksBook(true), BidsBook(false), vebose(true), ticker(_ticker)
+    // Book side structures, picked at compile time
+    template <OrderSide SIDE>
+    auto& book_of()
     {
-        engine = std::thread(&OrderEngine::matching_engine, this);
-    } 
+        if constexpr (SIDE == OrderSide::BID)
+            return BidsBook;
+        else
+            return AsksBook;
+    }
 
-    // Verbose Specifier
-    OrderEngine(const std::string& _ticker, bool _verbose) 
-    : engine_running(true), book_updated(false), recent_order_id(0), next_order_id(1), AsksBook(true), BidsBook(false), vebose(_verbose), ticker(_ticker)
+    template <OrderSide SIDE>
+    const auto& book_of() const
     {
-        engine = std::thread(&OrderEngine::matching_engine, this);
-    } 
-   
-    ~OrderEngine()
+        if constexpr (SIDE == OrderSide::BID)
+            return BidsBook;
+        else
+            return AsksBook;
+    }
+
+    template <OrderSide SIDE>
+    LevelMap& levels_of()
     {
-        std::unique_lock<std::mutex> lock(order_lock); 
-        engine_running = false;
-        book_updated = true;
-        order_cv.notify_all();
-        order_cv.wait(lock);
-        if (engine.joinable()) 
-            engine.join(); 
+        if constexpr (SIDE == OrderSide::BID)
+            return BidLevels;
+        else
+            return AskLevels;
     }
 
-    // POST: Place Limit Order
-    unsigned int place_order(const OrderSide _side, const OrderType _type,double _price, double _qty)
+    // Clamp a Limit Price that crosses the opposing best to that price
+    template <OrderSide SIDE>
+    std::int64_t marketable_price(const std::int64_t _price) const
     {
-        // Mutex
-        std::unique_lock<std::mutex> lock(order_lock);
-        
-        const unsigned int _id = next_order_id++; // New Order ID
+        const auto& book = book_of<opposite(SIDE)>();
+        if (book.size() && book.better(book.peek(), _price))
+            return book.peek(); // Adjust price to best bid (ASK) or best ask (BID)
+        return _price;
+    }
 
-        // New Order
-        std::shared_ptr<OrderInfo> new_order;
-        switch (_type)
+    // Rest an Order at the back of its price level, creating the level if needed
+    template <OrderSide SIDE>
+    void rest(OrderInfo* order)
+    {
+        touch(SIDE, order->price);
+        auto& book = book_of<SIDE>();
+        LevelMap& levels = levels_of<SIDE>();
+        if (!book.find(order->price))
         {
-            case OrderType::LIMIT: // Limit Order
+            book.push(order->price);
+            levels[order->price] = OrderLevel();
+        }
+        levels[order->price].push_back(order);
+    }
+
+    // Take a resting Order off its price level, dropping the level once empty
+    void unlink(OrderInfo* order)
+    {
+        touch(order->side, order->price);
+        OrderLevel& order_level = *order->level;
+        order_level.erase(order);
+
+        // If Order Level is empty pop from Book and erase Order Level
+        if (order_level.empty())
+        {
+            switch(order->side)
+            {
+                case OrderSide::BID:
                 {
-                    // If Limit Order is above (BID) or below (ASK) best opposing price, then adjust
-                    if (_side == OrderSide::ASK && BidsBook.size() && _price < BidsBook.peek())
-                        _price = BidsBook.peek(); // Adjust price to best bid
-                    else if (_side == OrderSide::BID && AsksBook.size() && _price > AsksBook.peek())
-                        _price = AsksBook.peek(); // Adjust price to best ask
-                    new_order = std::make_shared<OrderInfo>(_side, OrderType::LIMIT, _qty, _price, _id);
+                    BidsBook.pop(order->price);
+                    BidLevels.erase(order->price);
                     break;
                 }
 
-           case OrderType::MARKET: // Market Order
+                case OrderSide::ASK:
                 {
-                    // If Market Order, then get best opposing price
-                    _price = _side == OrderSide::ASK ? BidsBook.peek() : AsksBook.peek();
-                    new_order = std::make_shared<OrderInfo>(_side, OrderType::MARKET, _qty, _price, _id);
+                    AsksBook.pop(order->price);
+                    AskLevels.erase(order->price);
                     break;
                 }
-                
+            }
+        }
+    }
+
+    // Place Order
+    // Side and type are resolved once here, placement and matching below are specialized for the pair
+    OrderAck process_new(const OrderSide _side, const OrderType _type, const std::int64_t _price, const std::int64_t _qty, const unsigned int _id, const std::time_t _time, const std::uint32_t _account = 0)
+    {
+        switch (_type)
+        {
+            case OrderType::LIMIT: // Limit Order
+                return _side == OrderSide::BID ? place<OrderSide::BID, OrderType::LIMIT>(_price, _qty, _id, _time, _account) : place<OrderSide::ASK, OrderType::LIMIT>(_price, _qty, _id, _time, _account);
+
+            case OrderType::MARKET: // Market Order
+                return _side == OrderSide::BID ? place<OrderSide::BID, OrderType::MARKET>(_price, _qty, _id, _time, _account) : place<OrderSide::ASK, OrderType::MARKET>(_price, _qty, _id, _time, _account);
+
             default:
-                return 0; // Invalid Order Type
+                return {_id, OrderStatus::REJECTED}; // Invalid Order Type
+        }
+    }
+
+    template <OrderSide SIDE, OrderType TYPE>
+    OrderAck place(std::int64_t _price, const std::int64_t _qty, const unsigned int _id, const std::time_t _time, const std::uint32_t _account)
+    {
+        const auto& opposing = book_of<opposite(SIDE)>();
+        if constexpr (TYPE == OrderType::LIMIT)
+        {
+            // If Limit Order is above (BID) or below (ASK) best opposing price, then adjust (auctions keep the limit)
+            if (!auction && _price != OFF_TICK)
+                _price = marketable_price<SIDE>(_price);
+        }
+        else
+            _price = opposing.peek(); // If Market Order, then get best opposing price
+
+        // New Order
+        OrderInfo* new_order = OrderPool.acquire(SIDE, TYPE, _qty == OFF_LOT ? 0 : _qty, _price == OFF_TICK ? 0 : _price, _id, _time, _account);
+        OrderTable.insert(_id, new_order); // Key New Order
+
+        // Valid Limit Price
+        if constexpr (TYPE == OrderType::LIMIT)
+        {
+            if (_price == OFF_TICK)
+            {
+                notify_reject(new_order, RejectReason::PRICE_NOT_TICK_MULTIPLE);
+                retire(new_order);
+                return {_id, OrderStatus::REJECTED}; // Limit price is not a whole number of ticks
+            }
+            if (_price <= 0)
+            {
+                notify_reject(new_order, RejectReason::PRICE_BELOW_TICK);
+                retire(new_order);
+                return {_id, OrderStatus::REJECTED}; // Limit price rounds to zero ticks
+            }
+        }
+
+        // Valid Quantity
+        if (_qty == OFF_LOT)
+        {
+            notify_reject(new_order, RejectReason::QTY_NOT_LOT_MULTIPLE);
+            retire(new_order);
+            return {_id, OrderStatus::REJECTED}; // Quantity is not a whole number of lots
+        }
+        if (_qty <= 0)
+        {
+            notify_reject(new_order, RejectReason::QTY_BELOW_LOT);
+            retire(new_order);
+            return {_id, OrderStatus::REJECTED}; // Quantity rounds to zero lots
         }
-        
-        OrderTable[_id] = new_order; // Key New Order
 
         // Valid Market
-        if (_type == OrderType::MARKET) 
+        if constexpr (TYPE == OrderType::MARKET)
         {
-            if (_side == OrderSide::ASK && !BidsBook.size())
+            if (auction)
             {
-                notify_reject(_id, "NO MARKET LIQUIDITY (BIDS)");
-                return 0; // No bids to match with
+                notify_reject(new_order, RejectReason::MARKET_IN_AUCTION);
+                retire(new_order);
+                return {_id, OrderStatus::REJECTED}; // Nothing to price it against until the uncross
             }
-            if (_side == OrderSide::BID && !AsksBook.size())
+            if (!opposing.size())
             {
-                notify_reject(_id, "NO MARKET LIQUIDITY (ASKS)");
-                return 0; // No asks to match with
+                notify_reject(new_order, SIDE == OrderSide::ASK ? RejectReason::NO_LIQUIDITY_BIDS : RejectReason::NO_LIQUIDITY_ASKS);
+                retire(new_order);
+                return {_id, OrderStatus::REJECTED}; // No opposing orders to match with
             }
         }
         
         // Place Order
-        switch (_side)
-        {
-            case OrderSide::ASK:
-                {
-                    // Create new ask price level if no price level
-                    if (AsksBook.find(_price) == -1)
-                    {
-                        AsksBook.push(_price);
-                        AskLevels[_price] = OrderLevel();
-                    }
-                    AskLevels[_price].push_back(new_order);
-                    break;
-                }
-            
-            case OrderSide::BID:
-                {
-                    // Create new bid price level if no price level
-                    if (BidsBook.find(_price) == -1)
-                    {
-                        BidsBook.push(_price);
-                        BidLevels[_price] = OrderLevel();
-                    }
-                    BidLevels[_price].push_back(new_order);
-                    break;
-                }
-            
-            default:
-                return 0; // Invalid Order Side
-        }
+        rest<SIDE>(new_order);
 
         // Notifiy Open
-        notify_open(_id);
+        notify_open(new_order);
+        if (auction)
+            return {_id, OrderStatus::OPEN}; // Waits for the uncross
         recent_order_id = _id;
 
-        // Notify Matching Engine
-        book_updated = true;
-        order_cv.notify_all();
-        order_cv.wait(lock, [this]{ 
-            return !book_updated; 
-        }); // Wait for matching engine
-        return _id; // Return Order ID
+        // Match Recent Order
+        const OrderStatus status = match<SIDE>(new_order);
+        return {_id, status}; // Return Order ID
     }
 
-    // POST: Cancel Order
-    bool cancel_order(const unsigned int _id)
+    // Cancel Order
+    OrderAck process_cancel(const unsigned int _id)
     {
-        // Mutex
-        std::unique_lock<std::mutex> lock(order_lock);
- 
-        if (OrderTable.find(_id) == OrderTable.end()) 
-            return false; // Order does not exist;
+        OrderInfo* const* found = OrderTable.find(_id);
+        if (!found) 
+            return {_id, OrderStatus::REJECTED}; // Order does not exist;
         
-        auto& order = OrderTable[_id];
+        OrderInfo* order = *found;
         if (order->status != OrderStatus::OPEN || order->type != OrderType::LIMIT)
-            return false; // Order is not open and not a limit order
+            return {_id, OrderStatus::REJECTED}; // Order is not open and not a limit order
+
+        // Unlink Order from its Level
+        unlink(order);
+
+        // Notify Cancel
+        notify_cancel(order);
+        retire(order);
+        return {_id, OrderStatus::CANCELLED}; // Order successfully canceled
+    }
+
+    // Open an Auction Call
+    OrderAck process_auction()
+    {
+        if (auction)
+            return {0, OrderStatus::REJECTED}; // Already in an auction call
+        auction = true;
+        return {0, OrderStatus::OPEN};
+    }
+
+    // Uncross the Auction at its equilibrium and resume continuous matching
+    OrderAck process_uncross()
+    {
+        if (!auction)
+            return {0, OrderStatus::REJECTED}; // No auction call to uncross
+        last_auction = equilibrium();
+        if (last_auction.price != -1)
+            cross(last_auction.price, last_auction.qty);
+        auction = false;
+        return {0, OrderStatus::OPEN};
+    }
 
-        // Get Order Level based on Order Side
-        auto& order_level = (order->side == OrderSide::BID) ?
-        BidLevels[order->price] : AskLevels[order->price];
+    // Equilibrium of the crossed part of the Book (-1 price if it does not cross)
+    // Every price in [best ask, best bid] that a level sits at is a candidate, and trades min(demand, supply) there.
+    // The most volume wins, then the smallest imbalance, then the price nearest the last trade (or the mid)
+    AuctionQuote equilibrium() const
+    {
+        AuctionQuote quote{-1, 0, 0};
+        const std::int64_t best_bid = BidsBook.peek();
+        const std::int64_t best_ask = AsksBook.peek();
+        if (best_bid == -1 || best_ask == -1 || best_bid < best_ask)
+            return quote; // Book does not cross
 
-        // Iterate thruogh order level filtering out ORDER ID
-        OrderLevel new_level;
-        for (auto& cur_order : order_level)
+        // Crossing levels, both ascending
+        std::vector<std::pair<std::int64_t, std::int64_t>> bids;
+        std::vector<std::pair<std::int64_t, std::int64_t>> asks;
+        std::int64_t bid_total = 0;
+        for (std::int64_t price = best_bid; price != -1 && price >= best_ask; price = BidsBook.next(price))
         {
-            if (cur_order->id != _id) new_level.push_back(cur_order);
+            bids.emplace_back(price, BidLevels.at(price).total_qty);
+            bid_total += bids.back().second;
         }
-        order_level = std::move(new_level);
+        std::reverse(bids.begin(), bids.end());
+        for (std::int64_t price = best_ask; price != -1 && price <= best_bid; price = AsksBook.next(price))
+            asks.emplace_back(price, AskLevels.at(price).total_qty);
 
-        // If Order Level is empty pop from Book and erase Order Level
-        if (order_level.empty())
+        // Sweep the candidates upwards, supply grows and demand shrinks
+        const std::int64_t reference = last_trade_price != -1 ? last_trade_price : (best_bid + best_ask) / 2;
+        std::int64_t supply = 0; // Ask lots priced at or below the candidate
+        std::int64_t below = 0; // Bid lots priced under the candidate
+        std::size_t b = 0;
+        std::size_t a = 0;
+        while (b < bids.size() || a < asks.size())
         {
-            switch(order->side)
+            const std::int64_t price = a < asks.size() && (b == bids.size() || asks[a].first <= bids[b].first) ? asks[a].first : bids[b].first;
+            for (; a < asks.size() && asks[a].first <= price; ++a)
+                supply += asks[a].second;
+            const std::int64_t demand = bid_total - below;
+            const std::int64_t volume = std::min(demand, supply);
+            const std::int64_t imbalance = demand - supply;
+            if (quote.price == -1 || volume > quote.qty ||
+                (volume == quote.qty && (std::abs(imbalance) < std::abs(quote.imbalance) ||
+                (std::abs(imbalance) == std::abs(quote.imbalance) && std::abs(price - reference) < std::abs(quote.price - reference)))))
+                quote = {price, volume, imbalance};
+            for (; b < bids.size() && bids[b].first <= price; ++b)
+                below += bids[b].second;
+        }
+        return quote;
+    }
+
+    // Trade the crossed Book at one price, best bids against best asks in time priority, until it no longer crosses
+    // (at the equilibrium that is exactly _volume lots)
+    void cross(const std::int64_t _price, const std::int64_t _volume)
+    {
+        std::uint64_t trades = 0;
+        while (BidsBook.size() && AsksBook.size() && BidsBook.peek() >= _price && AsksBook.peek() <= _price)
+        {
+            const std::int64_t bid_price = BidsBook.peek();
+            const std::int64_t ask_price = AsksBook.peek();
+            auto bid_level = BidLevels.find(bid_price);
+            auto ask_level = AskLevels.find(ask_price);
+            if (bid_level == BidLevels.end() || ask_level == AskLevels.end())
+                break; // No level to match with
+            OrderLevel& bids = bid_level->second;
+            OrderLevel& asks = ask_level->second;
+            touch(OrderSide::BID, bid_price);
+            touch(OrderSide::ASK, ask_price);
+
+            // Pair the two levels front to back until one runs out
+            while (!bids.empty() && !asks.empty())
             {
-                case OrderSide::BID:
+                OrderInfo* buyer = bids.front();
+                OrderInfo* seller = asks.front();
+                const std::int64_t qty_filled = std::min(buyer->qty, seller->qty);
+                bids.reduce(buyer, qty_filled);
+                asks.reduce(seller, qty_filled);
+                ++trades;
+
+                // Ask side reports first
+                notify_fill(seller, qty_filled, _price);
+                notify_fill(buyer, qty_filled, _price);
+                if (!seller->qty)
                 {
-                    const auto& bid = BidsBook.find(order->price);
-                    if (bid != -1)
-                    {
-                        BidsBook.pop(bid);
-                        BidLevels.erase(order->price);
-                    }
-                    break;
+                    asks.pop_front();
+                    retire(seller);
                 }
-
-                case OrderSide::ASK:
+                if (!buyer->qty)
                 {
-                    const auto& ask = AsksBook.find(order->price);
-                    if (ask != -1)
-                    {
-                        AsksBook.pop(ask);
-                        AskLevels.erase(order->price);
-                    }
-                    break;
+                    bids.pop_front();
+                    retire(buyer);
                 }
+            }
 
-                default:
-                    return false; // Invalid Order Side
+            // Erase whichever levels emptied
+            if (bids.empty())
+            {
+                BidsBook.pop(bid_price);
+                BidLevels.erase(bid_level);
+            }
+            if (asks.empty())
+            {
+                AsksBook.pop(ask_price);
+                AskLevels.erase(ask_level);
             }
         }
-
-        // Notify Cancel
-        notify_cancel(_id);
-
-        // Notify Matching Engine
-        book_updated = true;
-        order_cv.notify_all();
-        order_cv.wait(lock, [this]() { return !book_updated; });
-        return true; // Order successfully canceled
+        if (!trades)
+            return;
+        last_trade_price = _price;
+        last_trade_qty = _volume; // The uncross prints as one trade
+        if (!replaying)
+            fills.fetch_add(trades, std::memory_order_relaxed);
     }
 
-    // PATCH: Edit Order
-    unsigned int edit_order(const unsigned int _id, const OrderSide _side, const double _price, const double _qty)
+    // Match the Recent Order against the opposing Book, returns its status afterwards
+    // Sweeps level by level: each opposing level is looked up and touched once, then its FIFO is consumed
+    // until the level or the recent order runs out. Specialized per aggressor side, so the price and report order
+    // checks in the loops are fixed at compile time
+    template <OrderSide SIDE>
+    OrderStatus match(OrderInfo* aggressor)
     {
-        if (!cancel_order(_id))
-            return 0; // If cancel failed
-        return place_order(_side, OrderType::LIMIT, _qty, _price);
-    }
+        // Get the Book the Recent Order trades against
+        constexpr OrderSide PASSIVE = opposite(SIDE);
+        constexpr bool buying = SIDE == OrderSide::BID;
+        auto& book = book_of<PASSIVE>();
+        LevelMap& levels = levels_of<PASSIVE>();
+        OrderLevel& own_level = *aggressor->level; // The recent order rests (and was touched) before it matches
+        std::uint64_t trades = 0;
 
-    // GET: Get Order
-    std::shared_ptr<OrderInfo> get_order(const unsigned int& _id) const
-    { 
-            const auto& order = OrderTable.find(_id);
-            if (order == OrderTable.end())
-                return nullptr; // Return nullptr if order not found
-            return order->second; 
-    }
+        // Match order while there is a qty and the opposing best crosses its price
+        while (aggressor->qty && book.size())
+        {
+            const std::int64_t price = book.peek();
+            if (book.better(aggressor->price, price))
+                break; // No match possible
+            auto found = levels.find(price);
+            if (found == levels.end())
+                break; // No best price level to match with
+            OrderLevel& level = found->second;
+            touch(PASSIVE, price);
 
-    // GET: Average Price
-    double get_price() const 
-    {
-        if (!BidsBook.size() && !AsksBook.size())
-            return -1; // If both books are empty
-        else if (!BidsBook.size())
-            return AsksBook.peek(); // If BidBook is empty
-        else if (!AsksBook.size())
-            return BidsBook.peek(); // If AskBook is Empty
-        return (AsksBook.peek() + BidsBook.peek()) / 2; // Average of best ask and bid
-    }
+            // Consume the level front to back
+            while (aggressor->qty && !level.empty())
+            {
+                const LevelSlot& slot = level.front_slot();
+                OrderInfo* resting = slot.order;
+                const std::int64_t qty_filled = std::min(slot.qty, aggressor->qty);
+                level.reduce(resting, qty_filled);
+                own_level.reduce(aggressor, qty_filled);
+                last_trade_qty = qty_filled;
+                ++trades;
 
-    // GET: Best Ask
-    double get_best_ask() const 
-    {
-        if (!AsksBook.size()) return -1;
-        return AsksBook.peek();
+                // Ask side reports first
+                notify_fill(buying ? resting : aggressor, qty_filled);
+                notify_fill(buying ? aggressor : resting, qty_filled);
+
+                // Resting orders retire as they fill, the recent order retires after the sweep
+                if (!resting->qty)
+                {
+                    level.pop_front();
+                    retire(resting);
+                }
+            }
+            last_trade_price = price;
+
+            // If the level is now empty then erase it and move to the next one
+            if (level.empty())
+            {
+                book.pop(price);
+                levels.erase(found);
+            }
+        }
+        if (trades && !replaying)
+            fills.fetch_add(trades, std::memory_order_relaxed);
+
+        // Unlink the Recent Order from its level once filled
+        if (!aggressor->qty)
+        {
+            own_level.erase(aggressor);
+            if (own_level.empty())
+            {
+                book_of<SIDE>().pop(aggressor->price);
+                levels_of<SIDE>().erase(aggressor->price);
+            }
+        }
+
+        // Retire Recent Order once it is no longer resting
+        const OrderStatus status = aggressor->status;
+        if (status != OrderStatus::OPEN)
+            retire(aggressor);
+        return status;
     }
 
-    // GET: Best Bid
-    double get_best_bid() const 
+    // Publish the Top of Book if a command changed it
+    void publish_top()
     {
-        if (!BidsBook.size()) return -1;
-        return BidsBook.peek();
+        TopOfBook next = top;
+        next.bid = BidsBook.peek();
+        next.ask = AsksBook.peek();
+        next.bid_qty = next.bid == -1 ? 0 : BidLevels.at(next.bid).total_qty;
+        next.ask_qty = next.ask == -1 ? 0 : AskLevels.at(next.ask).total_qty;
+        next.last_price = last_trade_price;
+        next.last_qty = last_trade_qty;
+        if (next.bid == top.bid && next.ask == top.ask && next.bid_qty == top.bid_qty && next.ask_qty == top.ask_qty &&
+            next.last_price == top.last_price && next.last_qty == top.last_qty)
+            return; // Nothing visible changed
+        ++next.seq;
+        top = next;
+        Top.store(top);
     }
 
-    // GET: Orders by Status
-    std::vector<std::shared_ptr<OrderInfo>> get_orders_by_status(OrderStatus status) const 
+    // Append an applied Command to the Journal
+    void journal(const OrderCommand& cmd, const std::time_t _time)
     {
-        std::vector<std::shared_ptr<OrderInfo>> result;
-        for (const auto& [id, order] : OrderTable) 
-        {
-            if (order->status == status)
-                result.push_back(order);
-        }
-        return std::move(result);
+        if (!Journal.enabled())
+            return; // Journaling disabled
+        Journal.publish(JournalEntry{++journal_seq, _time, cmd.price, cmd.qty, cmd.id, cmd.account, cmd.type, cmd.side, cmd.order_type});
     }
-    
-    // GET: Maket Depth
-    std::vector<std::pair<double, std::size_t>> get_market_depth(OrderSide _side, std::size_t _depth = 10) const
+
+    // Replay the Journal (if any) into the empty Book, then keep appending to it
+    void open_journal(const EngineConfig& _config)
     {
-        std::vector<std::pair<double, std::size_t>> depth;
+        if (_config.journal_path.empty())
+            return;
 
-        switch(_side)
+        unsigned int last_id = next_order_id - 1;
+        const std::uint64_t snapshot_seq = journal_seq; // Entries up to here are already in the snapshot
+        replaying = true;
+        const std::size_t entries = read_records<JournalEntry>(_config.journal_path, [&](const JournalEntry& entry)
         {
-            case OrderSide::BID:
-                {
-                    auto tmp_book = BidsBook; // Copy BidsBook
-                    for (size_t i = 0; i < _depth && tmp_book.size(); ++i)
-                    {
-                        double best_bid = tmp_book.peek(); // Get Best Bid Price
-                        const auto& best_level = BidLevels.at(best_bid); // Get Best Bid Level
-
-                        double total_qty = 0;
-                        // Sum up all Quantities on current price level
-                        for (auto& order : best_level)
-                            total_qty += order->qty;
-
-                        depth.emplace_back(best_bid, total_qty);
-                        tmp_book.pop();
-                    }
+            if (entry.seq <= snapshot_seq)
+                return;
+            ++replayed;
+            switch (entry.type)
+            {
+                case CommandType::NEW:
+                    process_new(entry.side, entry.order_type, entry.price, entry.qty, entry.id, entry.time, entry.account);
                     break;
-                }
 
-            case OrderSide::ASK:
-                {
-                    auto tmp_book = AsksBook; // Copy AsksBook
-                    for (size_t i = 0; i < _depth && tmp_book.size(); ++i)
-                    {
-                        double best_ask = tmp_book.peek(); // Get Best Ask Price
-                        const auto& best_level = AskLevels.at(best_ask); // Get Best Ask Level
-
-                        double total_qty = 0;
-                        // Sum up all Quantities on current price level
-                        for (auto& order : best_level)
-                            total_qty += order->qty;
-
-                        depth.emplace_back(best_ask, total_qty);
-                        tmp_book.pop();
-                    }
+                case CommandType::CANCEL:
+                    process_cancel(entry.id);
                     break;
-                }
-        }
-       
-        return std::move(depth);
+
+                case CommandType::AMEND:
+                    process_amend(entry.id, entry.price, entry.qty);
+                    break;
+
+                case CommandType::AUCTION:
+                    process_auction();
+                    break;
+
+                case CommandType::UNCROSS:
+                    process_uncross();
+                    break;
+
+                case CommandType::SNAPSHOT:
+                    break; // Never journaled
+            }
+            last_id = std::max(last_id, entry.id);
+            journal_seq = entry.seq;
+        });
+        replaying = false;
+        next_order_id = last_id + 1;
+        recovered = recovered || replayed;
+        publish_top();
+
+        // Drop a torn tail record so appends stay aligned
+        std::error_code error;
+        if (std::filesystem::file_size(_config.journal_path, error) > entries * sizeof(JournalEntry))
+            std::filesystem::resize_file(_config.journal_path, entries * sizeof(JournalEntry), error);
+        if (!Journal.record_to(_config.journal_path, _config.journal_fsync) && vebose)
+            std::cerr << "[" << ticker << "] Failed to open journal " << _config.journal_path << '\n';
     }
 
-private:
-    // Order Book
-    PriceHeap AsksBook; // Asks Order Book
-    PriceHeap BidsBook; // Bids Order Book
-    LevelMap AskLevels; // Asks Price Levels
-    LevelMap BidLevels; // Bids Price Levels
-    OrderMap OrderTable; // Map to all active orders
-    unsigned int recent_order_id; // New Orders ID
-    unsigned int next_order_id; // Next Order ID
+    // Copy the Book into Snapshot File layout
+    std::vector<std::byte> snapshot_image() const
+    {
+        std::unique_lock<std::mutex> lock(order_lock);
+        std::vector<SnapshotLevel> levels;
+        std::vector<SnapshotOrder> orders;
+        orders.reserve(OrderTable.size());
+        auto copy_side = [&](const auto& book, const LevelMap& side_levels)
+        {
+            for (std::int64_t price = book.peek(); price != -1; price = book.next(price))
+            {
+                const OrderLevel& level = side_levels.at(price);
+                levels.push_back(SnapshotLevel{price, level.total_qty, orders.size(), level.count});
+                level.for_each([&](const OrderInfo* order)
+                {
+                    orders.push_back(SnapshotOrder{order->price, order->qty, order->time, order->id, order->account, order->side, order->type});
+                });
+            }
+        };
+        copy_side(BidsBook, BidLevels);
+        const std::size_t bid_levels = levels.size();
+        copy_side(AsksBook, AskLevels);
 
-    // Concurreny
-    std::thread engine;
-    std::mutex order_lock;
-    std::condition_variable order_cv;
-    std::atomic<bool> engine_running;
-    bool book_updated;
+        SnapshotHeader header{};
+        std::memcpy(header.magic, BookSnapshot::MAGIC, sizeof(header.magic));
+        header.version = BookSnapshot::VERSION;
+        header.next_order_id = next_order_id.load();
+        header.journal_seq = journal_seq;
+        header.tick_size = tick_size;
+        header.lot_size = lot_size;
+        header.last_trade_price = last_trade_price;
+        header.last_trade_qty = last_trade_qty;
+        header.bid_levels = bid_levels;
+        header.ask_levels = levels.size() - bid_levels;
+        header.orders = orders.size();
+        header.auction = auction ? 1 : 0;
+        lock.unlock();
 
-    bool vebose; // Verbose Mode
-    std::string ticker; // Ticker
+        std::vector<std::byte> image(sizeof(header) + levels.size() * sizeof(SnapshotLevel) + orders.size() * sizeof(SnapshotOrder));
+        std::byte* out = image.data();
+        std::memcpy(out, &header, sizeof(header));
+        out += sizeof(header);
+        std::memcpy(out, levels.data(), levels.size() * sizeof(SnapshotLevel));
+        out += levels.size() * sizeof(SnapshotLevel);
+        std::memcpy(out, orders.data(), orders.size() * sizeof(SnapshotOrder));
+        return image;
+    }
 
-    // Matching Engine
-    void matching_engine()
+    // Rebuild the empty Book from a Snapshot (if any), false if nothing was loaded
+    bool load_snapshot(const EngineConfig& _config)
     {
-        while (engine_running.load())
+        BookSnapshot snapshot;
+        if (_config.snapshot_path.empty() || !snapshot.open(_config.snapshot_path))
+            return false;
+        const SnapshotHeader& header = snapshot.header();
+        if (header.tick_size != tick_size)
         {
-            // Sleep Lock
-            std::unique_lock<std::mutex> lock(order_lock);
-            order_cv.wait(lock, [this]{ 
-                    return  !engine_running || book_updated; 
-            });
-            
-            auto is_recent_order = OrderTable.find(recent_order_id) != OrderTable.end();
-            auto is_books = AsksBook.size() && BidsBook.size();
-            // Attempt to Match only if engine is running, there is a recent order placed, and there are orders on both sides
-            if (engine_running && is_recent_order && is_books)
+            if (vebose)
+                std::cerr << "[" << ticker << "] Snapshot tick size " << header.tick_size << " does not match " << tick_size << '\n';
+            return false;
+        }
+        if (header.lot_size != lot_size)
+        {
+            if (vebose)
+                std::cerr << "[" << ticker << "] Snapshot lot size " << header.lot_size << " does not match " << lot_size << '\n';
+            return false;
+        }
+
+        const std::span<const SnapshotOrder> orders = snapshot.orders();
+        auto restore_side = [&](std::span<const SnapshotLevel> levels, auto& book, LevelMap& side_levels)
+        {
+            for (const SnapshotLevel& level : levels)
             {
-                // Get Recent Order
-                std::shared_ptr<OrderInfo>& recent_order = OrderTable[recent_order_id];
-                // Match order while order status is Open and there is a qty
-                while (recent_order->status == OrderStatus::OPEN && recent_order->qty)
+                if (!level.count || level.first + level.count > orders.size())
+                    continue; // Corrupt level
+                book.push(level.price);
+                OrderLevel& resting = side_levels[level.price];
+                for (const SnapshotOrder& saved : orders.subspan(level.first, level.count))
                 {
-                    // Get best asks and bids
-                    const double& best_asks_price = AsksBook.peek();
-                    const double& best_bids_price = BidsBook.peek();
-                    if (AskLevels.find(best_asks_price) == AskLevels.end() ||
-                        BidLevels.find(best_bids_price) == BidLevels.end())
-                        break; // No best price level to match with
-                        
-                    // Get price level for best asks and bids
-                    OrderLevel& best_level_asks = AskLevels[best_asks_price];
-                    OrderLevel& best_level_bids = BidLevels[best_bids_price];
-                    if (best_level_asks.empty() || best_level_bids.empty())
-                        break; // No best level to match with
-                    
-                    // Get OrderInfo for best ask and bid
-                    std::shared_ptr<OrderInfo>& best_ask = best_level_asks.front();
-                    std::shared_ptr<OrderInfo>& best_bid = best_level_bids.front();
-                    
-                    // Break If you can't trade
-                    const bool can_trade_asks = recent_order->side == OrderSide::ASK && 
-                    !best_level_bids.empty() && best_bid->price >= recent_order->price;
-                    const bool can_trade_bids = recent_order->side == OrderSide::BID && 
-                    !best_level_asks.empty() && best_ask->price <= recent_order->price;
-                    if (!(can_trade_asks || can_trade_bids)) 
-                        break; // No match possible
-
-                    switch (recent_order->side)
-                    {
-                        case OrderSide::ASK:
-                            {
-                                matching(recent_order, best_bid, best_level_asks, best_level_bids);
-                                break;
-                            }
-                        
-                        case OrderSide::BID:
-                            {
-                                matching(best_ask, recent_order, best_level_asks, best_level_bids);
-                                break;
-                            }
-                    }                
+                    OrderInfo* order = OrderPool.acquire(saved.side, saved.type, saved.qty, saved.price, saved.id, saved.time, saved.account);
+                    OrderTable.insert(saved.id, order);
+                    resting.push_back(order);
+                    count_status(OrderStatus::OPEN, 1);
                 }
-            } 
-            
-            // Notify Order Engine
-            book_updated = false;
-            order_cv.notify_all();
-        }
+            }
+        };
+        restore_side(snapshot.bids(), BidsBook, BidLevels);
+        restore_side(snapshot.asks(), AsksBook, AskLevels);
+
+        next_order_id = header.next_order_id;
+        journal_seq = header.journal_seq;
+        last_trade_price = header.last_trade_price;
+        last_trade_qty = header.last_trade_qty;
+        auction = header.auction != 0;
+        publish_top();
+        return true;
     }
 
-    // Match Orders
-    void matching(std::shared_ptr<OrderInfo>& best_ask, std::shared_ptr<OrderInfo>& best_bid, OrderLevel& best_level_asks, OrderLevel& best_level_bids)
-    {   
-        // Get qty filled and apply difference
-        const double qty_filled = std::min(best_ask->qty, best_bid->qty);
-        best_ask->qty -= qty_filled;
-        best_bid->qty -= qty_filled;
-        
-        notify_fill(best_ask->id, qty_filled);
-        notify_fill(best_bid->id, qty_filled);
+    // Remember a Level's state before the current command changes it
+    void touch(const OrderSide _side, const std::int64_t _price)
+    {
+        if (replaying || !MarketData.enabled())
+            return; // Nobody listening
+        for (auto it = Touched.rbegin(); it != Touched.rend(); ++it)
+            if (it->price == _price && it->side == _side)
+                return; // Already remembered
+        const LevelMap& levels = _side == OrderSide::BID ? BidLevels : AskLevels;
+        auto level = levels.find(_price);
+        if (level == levels.end())
+            Touched.push_back({_side, _price, false, 0, 0});
+        else
+            Touched.push_back({_side, _price, true, level->second.total_qty, level->second.count});
+    }
 
-        // If ask qty is 0 then notify fill and erase
-        if (!best_ask->qty)
+    // Publish one L2 Book Update per Level the command left changed
+    void publish_book_updates()
+    {
+        for (const TouchedLevel& touched : Touched)
         {
-            best_level_asks.pop_front();
-            // If ask level is now empty then erase level
-            if (!best_level_asks.size())
+            const LevelMap& levels = touched.side == OrderSide::BID ? BidLevels : AskLevels;
+            auto level = levels.find(touched.price);
+            if (level == levels.end())
             {
-                AsksBook.pop();
-                AskLevels.erase(best_ask->price);
+                if (touched.existed)
+                    publish_book_update(BookAction::DELETE, touched.side, touched.price, 0, 0);
+                continue; // Created and consumed within the command otherwise
             }
+            const OrderLevel& now = level->second;
+            if (!touched.existed)
+                publish_book_update(BookAction::ADD, touched.side, touched.price, now.total_qty, now.count);
+            else if (now.total_qty != touched.qty || now.count != touched.count)
+                publish_book_update(BookAction::MODIFY, touched.side, touched.price, now.total_qty, now.count);
         }
+        Touched.clear();
+
+        // Periodic full snapshot so consumers can recover from gaps
+        if (snapshot_interval && updates_since_snapshot >= snapshot_interval)
+            publish_snapshot();
+    }
 
-        // If ask qty is 0 then notify fill and erase
-        if (!best_bid->qty)
+    // Publish the whole Book as SNAPSHOT_BEGIN, one SNAPSHOT_LEVEL per level (bids then asks, best first), SNAPSHOT_END
+    // A deep book outgrows the ring, so the consumer is woken every SNAPSHOT_CHUNK levels to drain while the rest goes out
+    void publish_snapshot()
+    {
+        updates_since_snapshot = 0;
+        if (!MarketData.enabled())
+            return; // Nobody listening
+        MarketData.publish(BookUpdate{++market_data_seq, 0, 0, std::uint32_t(BidsBook.size() + AsksBook.size()), OrderSide::BID, BookAction::SNAPSHOT_BEGIN});
+        std::size_t published = 0;
+        for (std::int64_t price = BidsBook.peek(); price != -1; price = BidsBook.next(price))
         {
-            best_level_bids.pop_front();
-            // If ask level is now empty then erase level
-            if (!best_level_bids.size())
-            {
-                BidsBook.pop();
-                BidLevels.erase(best_bid->price);
-            }
+            const OrderLevel& level = BidLevels.at(price);
+            MarketData.publish(BookUpdate{++market_data_seq, price, level.total_qty, std::uint32_t(level.count), OrderSide::BID, BookAction::SNAPSHOT_LEVEL});
+            if (++published % SNAPSHOT_CHUNK == 0)
+                MarketData.notify();
         }
+        for (std::int64_t price = AsksBook.peek(); price != -1; price = AsksBook.next(price))
+        {
+            const OrderLevel& level = AskLevels.at(price);
+            MarketData.publish(BookUpdate{++market_data_seq, price, level.total_qty, std::uint32_t(level.count), OrderSide::ASK, BookAction::SNAPSHOT_LEVEL});
+            if (++published % SNAPSHOT_CHUNK == 0)
+                MarketData.notify();
+        }
+        MarketData.publish(BookUpdate{++market_data_seq, 0, 0, 0, OrderSide::BID, BookAction::SNAPSHOT_END});
     }
 
-    // Notify of what Orders are open
-    void notify_open(const unsigned int& _id)
+    void publish_book_update(const BookAction _action, const OrderSide _side, const std::int64_t _price, const std::int64_t _qty, const std::size_t _count)
+    {
+        MarketData.publish(BookUpdate{++market_data_seq, _price, _qty, std::uint32_t(_count), _side, _action});
+        ++updates_since_snapshot;
+    }
+
+    // Move a terminal Order out of the live table into History and recycle its record
+    void retire(OrderInfo* order)
+    {
+        History.push(*order);
+        OrderTable.erase(order->id);
+        OrderPool.release(order);
+    }
+
+    // Publish an Execution Report for an Order
+    // Fills carry the trade price, other reports the order's own price
+    void report(const ReportType _type, const OrderInfo* order, const std::int64_t _qty, const RejectReason _reason = RejectReason::NONE, const std::int64_t _price = -1)
+    {
+        if (replaying || !Reports.enabled())
+            return; // Nobody listening (or replaying the journal)
+        Reports.publish(ExecutionReport{++report_seq, std::time(nullptr), _price == -1 ? order->price : _price, _qty, order->qty, order->id, _type, order->side, order->type, _reason, order->account});
+    }
+
+    // Adjust a Status Counter (engine thread only)
+    void count_status(const OrderStatus _status, const std::int64_t _by)
     {
-        if (OrderTable.find(_id) == OrderTable.end()) 
-            throw std::runtime_error("Could Not Find Open Order");
+        StatusCounts[std::size_t(_status)].fetch_add(std::uint64_t(_by), std::memory_order_relaxed);
+    }
 
-        const std::shared_ptr<OrderInfo>& order = OrderTable[_id];
-        const std::string _side = order->side == OrderSide::BID ? "BUY" : "SELL";
-        const std::string _type = order->type == OrderType::LIMIT ? "LIMIT" : "MARKET";
-        const std::string ticker_msg = "[" + ticker + "]";
+    // Notify of what Orders are open
+    void notify_open(OrderInfo* order)
+    {
         order->status = OrderStatus::OPEN; // Update Order Status
-        
-        // Notification
-        if (!vebose) return; // If not verbose, do not notify
-        std::cout << ticker_msg << " | " << "[OPEN] | " << "TYPE: " << _type << " | ID: " << order->id << " | SIDE: " << _side << 
-        " | QTY: " << order->qty << " | PRICE: " << order->price << " | TIME: "  << order->time << std::endl;
+        count_status(OrderStatus::OPEN, 1);
+        report(ReportType::OPEN, order, order->qty);
     }
 
     // Notify of what Orders were filled
-    void notify_fill(const unsigned int& _id, const double& qty_filled)
+    void notify_fill(OrderInfo* order, const std::int64_t qty_filled, const std::int64_t _price = -1)
     {
-        if (OrderTable.find(_id) == OrderTable.end()) 
-            throw std::runtime_error("Could Not Find Filled Order");
-
-        const std::shared_ptr<OrderInfo>& order = OrderTable[_id];
-        const std::string _side = order->side == OrderSide::BID ? "BUY" : "SELL";
-        const std::string _type = order->type == OrderType::LIMIT ? "LIMIT" : "MARKET";
-        const std::string status = !order->qty ? "[FILLED]" : "[PARTIALLY FILLED]";
-        const std::string ticker_msg = "[" + ticker + "]";
         if (!order->qty)
+        {
             order->status = OrderStatus::FILLED; // Update Order Status
-
-        // Time Order was Filled
-        const std::time_t& _time = time(0);
-        
-        // Notification
-        if (!vebose) return; // If not verbose, do not notify
-        std::cout << ticker_msg << " | " << status << " | " << "TYPE: " << _type << " | ID: " << order->id << " | SIDE: " << _side << 
-        " | QTY: " << qty_filled << " | PRICE: " << order->price << " | TIME: "  << _time << std::endl;
+            count_status(OrderStatus::OPEN, -1);
+            count_status(OrderStatus::FILLED, 1);
+        }
+        report(order->qty ? ReportType::PARTIAL_FILL : ReportType::FILL, order, qty_filled, RejectReason::NONE, _price);
     }
 
     // Notify of what Orders were canceled
-    void notify_cancel(const unsigned int& _id)
+    void notify_cancel(OrderInfo* order)
     {
-        if (OrderTable.find(_id) == OrderTable.end()) 
-            throw std::runtime_error("Could Not Find Cancelled Order");
-
-        const std::shared_ptr<OrderInfo>& order = OrderTable[_id];
-        const std::string _side = order->side == OrderSide::BID ? "BUY" : "SELL";
-        const std::string _type = order->type == OrderType::LIMIT ? "LIMIT" : "MARKET";
-        const std::string ticker_msg = "[" + ticker + "]";
         order->status = OrderStatus::CANCELLED; // Update Order Status
-
-        // Time Order was Canceled
-        const std::time_t& _time = time(0);
-        
-        // Notification
-        if (!vebose) return; // If not verbose, do not notify
-        std::cout << ticker_msg << " | " << "[CANCELED] | " << "TYPE: " << _type << " | ID: " << order->id << " | SIDE: " << _side << 
-        " | QTY: " << order->qty << " | PRICE: " << order->price << " | TIME: "  << _time << std::endl;
+        count_status(OrderStatus::OPEN, -1);
+        count_status(OrderStatus::CANCELLED, 1);
+        report(ReportType::CANCEL, order, order->qty);
     }
 
-    // Notify of what Orders were canceled
-    void notify_reject(const unsigned int& _id, const std::string _err)
+    // Notify of what Orders were amended
+    void notify_amend(OrderInfo* order, const std::int64_t _previous_qty)
     {
-        if (OrderTable.find(_id) == OrderTable.end()) 
-            throw std::runtime_error("Could Not Find Rejected Order");
+        report(ReportType::AMEND, order, _previous_qty);
+    }
 
-        const std::shared_ptr<OrderInfo>& order = OrderTable[_id];
-        const std::string _side = order->side == OrderSide::BID ? "BUY" : "SELL";
-        const std::string _type = order->type == OrderType::LIMIT ? "LIMIT" : "MARKET";
-        const std::string reject_msg = "[REJECTED: " + _err +  "]";
-        const std::string ticker_msg = "[" + ticker + "]";
-        order->status = OrderStatus::REJECTED; // Update Order Status
+    // Notify of what Orders were rejected
+    void notify_reject(OrderInfo* order, const RejectReason _reason)
+    {
+        order->status = OrderStatus::REJECTED; // Update Order Status (rejected before it ever opened)
+        count_status(OrderStatus::REJECTED, 1);
+        report(ReportType::REJECT, order, order->qty, _reason);
+    }
 
-        // Time Order was Rejected
-        const std::time_t& _time = time(0);
-        
-        // Notification
-        if (!vebose) return; // If not verbose, do not notify
-        std::cout << ticker_msg << " | " << reject_msg << " | " << "TYPE: " << _type << " | ID: " << order->id << " | SIDE: " << _side << 
-        " | QTY: " << order->qty << " | PRICE: " << order->price << " | TIME: "  << _time << std::endl;
+    // Pretty-print an Execution Report (runs on the report consumer thread)
+    void print_report(const ExecutionReport& _report) const
+    {
+        const char* _side = _report.side == OrderSide::BID ? "BUY" : "SELL";
+        const char* _type = _report.order_type == OrderType::LIMIT ? "LIMIT" : "MARKET";
+        std::cout << "[" << ticker << "] | ";
+        switch (_report.type)
+        {
+            case ReportType::OPEN: std::cout << "[OPEN]"; break;
+            case ReportType::PARTIAL_FILL: std::cout << "[PARTIALLY FILLED]"; break;
+            case ReportType::FILL: std::cout << "[FILLED]"; break;
+            case ReportType::CANCEL: std::cout << "[CANCELED]"; break;
+            case ReportType::REJECT: std::cout << "[REJECTED: " << to_string(_report.reason) << "]"; break;
+            case ReportType::AMEND: std::cout << "[AMENDED]"; break;
+        }
+        std::cout << " | TYPE: " << _type << " | ID: " << _report.id << " | SIDE: " << _side << 
+        " | QTY: " << to_qty(_report.type == ReportType::AMEND ? _report.leaves : _report.qty) << " | PRICE: " << to_price(_report.price) << " | TIME: "  << _report.time << '\n';
     }
 };
@@ -0,0 +1,313 @@
+#pragma once
+#include "Exchange.cpp"
+#include <random>
+#include <cstdio>
+#include <cstring>
+
+// Order Flow Generator Settings (the same settings and seed always give the same flow)
+struct FlowConfig
+{
+    std::vector<std::string> tickers{"AAPL", "TSLA", "AMZN", "NVDA"};
+    std::uint64_t seed = 42;
+    std::size_t orders_per_ticker = 10000; // New orders per ticker (cancels come on top)
+    double ipo_price = 100.0;
+    double ipo_qty = 10000;
+    double tick_size = 0.01;
+    double lot_size = 1.0;
+    double volatility = 0.05; // Spread of limit prices around the reference price
+    double skew = 0.15; // -1.0 (bearish) to 1.0 (bullish)
+    double drift = 0.001; // Per-order volatility of the reference price random walk
+    double market_probability = 0.5; // Share of market orders
+    double cancel_probability = 0.05; // Chance a limit order is cancelled straight after
+    std::uint32_t max_lots = 100; // Order sizes run 1..max_lots lots
+};
+
+// Flow Record Actions
+enum class FlowAction : std::uint8_t
+{
+    LIMIT,
+    MARKET,
+    CANCEL
+};
+
+// Flow Record (16-byte binary record, one submission)
+struct FlowRecord
+{
+    std::int64_t price; // Limit Price in Ticks (0 for market orders and cancels)
+    std::uint32_t value; // Lots for orders, index of the cancelled order's record for cancels
+    std::uint16_t ticker; // Index into the flow's tickers
+    FlowAction action;
+    OrderSide side;
+};
+
+// Flow File
+// FlowHeader | FlowTicker[tickers] | FlowRecord[records]
+struct FlowHeader
+{
+    char magic[8]; // OrderFlow::MAGIC
+    std::uint32_t version;
+    std::uint32_t tickers;
+    std::uint64_t seed;
+    std::uint64_t records;
+    double tick_size;
+    double lot_size;
+    double ipo_price;
+    double ipo_qty;
+};
+
+struct FlowTicker
+{
+    char name[16]; // NUL-padded
+};
+
+// Pre-Generated Order Flow
+// Prices and sizes are already in ticks and lots, so replaying costs no RNG or rounding
+struct OrderFlow
+{
+    static constexpr char MAGIC[8] = "OFLOW1";
+    static constexpr std::uint32_t VERSION = 1;
+
+    std::vector<std::string> tickers;
+    std::vector<FlowRecord> records;
+    std::uint64_t seed = 0;
+    double tick_size = 0.01;
+    double lot_size = 1.0;
+    double ipo_price = 100.0;
+    double ipo_qty = 10000;
+
+    // Write to _path, false if it could not be written
+    bool save(const std::string& _path) const
+    {
+        FlowHeader header{};
+        std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+        header.version = VERSION;
+        header.tickers = tickers.size();
+        header.seed = seed;
+        header.records = records.size();
+        header.tick_size = tick_size;
+        header.lot_size = lot_size;
+        header.ipo_price = ipo_price;
+        header.ipo_qty = ipo_qty;
+        std::vector<FlowTicker> names(tickers.size(), FlowTicker{});
+        for (std::size_t i = 0; i < tickers.size(); ++i)
+            std::strncpy(names[i].name, tickers[i].c_str(), sizeof(names[i].name) - 1);
+
+        FILE* file = std::fopen(_path.c_str(), "wb");
+        if (!file)
+            return false;
+        const bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+            std::fwrite(names.data(), sizeof(FlowTicker), names.size(), file) == names.size() &&
+            std::fwrite(records.data(), sizeof(FlowRecord), records.size(), file) == records.size();
+        return !std::fclose(file) && written;
+    }
+
+    // Read from _path, false if missing, foreign or truncated
+    bool load(const std::string& _path)
+    {
+        MappedFile file;
+        if (!file.open(_path) || file.size() < sizeof(FlowHeader))
+            return false;
+        FlowHeader header;
+        std::memcpy(&header, file.data(), sizeof(header));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) || header.version != VERSION ||
+            file.size() != sizeof(FlowHeader) + header.tickers * sizeof(FlowTicker) + header.records * sizeof(FlowRecord))
+            return false;
+
+        const std::byte* in = file.data() + sizeof(FlowHeader);
+        tickers.clear();
+        for (std::uint32_t i = 0; i < header.tickers; ++i, in += sizeof(FlowTicker))
+        {
+            FlowTicker name;
+            std::memcpy(&name, in, sizeof(name));
+            tickers.emplace_back(name.name, strnlen(name.name, sizeof(name.name)));
+        }
+        records.resize(header.records);
+        std::memcpy(records.data(), in, header.records * sizeof(FlowRecord));
+        seed = header.seed;
+        tick_size = header.tick_size;
+        lot_size = header.lot_size;
+        ipo_price = header.ipo_price;
+        ipo_qty = header.ipo_qty;
+        return true;
+    }
+};
+
+// Generate a seeded Order Flow
+// Each ticker keeps its own reference price on a random walk (nothing reads the book, so the flow never depends on
+// how an engine happened to interleave), limit prices scatter around it with skew, and tickers are interleaved round robin
+inline OrderFlow generate_flow(const FlowConfig& _config)
+{
+    OrderFlow flow;
+    flow.tickers = _config.tickers;
+    flow.seed = _config.seed;
+    flow.tick_size = _config.tick_size;
+    flow.lot_size = _config.lot_size;
+    flow.ipo_price = _config.ipo_price;
+    flow.ipo_qty = _config.ipo_qty;
+    flow.records.reserve(std::size_t(double(_config.orders_per_ticker * _config.tickers.size()) * (1.0 + _config.cancel_probability)) + 16);
+
+    std::mt19937_64 rng(_config.seed);
+    std::normal_distribution<double> normal_dist(0.0, _config.volatility);
+    std::normal_distribution<double> drift_dist(0.0, _config.drift);
+    std::uniform_int_distribution<std::uint32_t> qty_dist(1, _config.max_lots);
+    std::uniform_real_distribution<double> offset_dist(-5, 5);
+    std::bernoulli_distribution side_bias(0.5 + _config.skew * 0.5); // skew biases toward BUY if >0
+    std::bernoulli_distribution market_chance(_config.market_probability);
+    std::bernoulli_distribution cancel_chance(_config.cancel_probability);
+    std::vector<double> reference(_config.tickers.size(), _config.ipo_price);
+
+    for (std::size_t i = 0; i < _config.orders_per_ticker * _config.tickers.size(); ++i)
+    {
+        const std::uint16_t ticker = std::uint16_t(i % _config.tickers.size());
+        double& price = reference[ticker];
+        price = std::max(_config.tick_size, price * (1.0 + drift_dist(rng)));
+
+        // Bias order side using skew
+        const OrderSide side = side_bias(rng) ? OrderSide::BID : OrderSide::ASK;
+        const bool market = market_chance(rng);
+        const std::uint32_t lots = qty_dist(rng);
+
+        // Apply skew to upward vs downward moves
+        double change = normal_dist(rng);
+        if (change > 0) change *= (1.0 + _config.skew); // upward amplified if bullish
+        else change *= (1.0 - _config.skew);            // downward dampened if bullish
+        const double limit = std::max(_config.tick_size, price * (1.0 + change) + offset_dist(rng));
+
+        const std::uint32_t index = flow.records.size();
+        if (market)
+        {
+            flow.records.push_back(FlowRecord{0, lots, ticker, FlowAction::MARKET, side});
+            continue;
+        }
+        flow.records.push_back(FlowRecord{std::max<std::int64_t>(1, std::llround(limit / _config.tick_size)), lots, ticker, FlowAction::LIMIT, side});
+        if (cancel_chance(rng))
+            flow.records.push_back(FlowRecord{0, index, ticker, FlowAction::CANCEL, side});
+    }
+    return flow;
+}
+
+// 64-bit FNV-1a (replay result fingerprint)
+class Fnv1a
+{
+public:
+    template <typename T>
+    void add(const T& _value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Hashed as raw bytes");
+        const auto* bytes = reinterpret_cast<const unsigned char*>(&_value);
+        for (std::size_t i = 0; i < sizeof(T); ++i)
+            hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    }
+
+    std::uint64_t value() const { return hash; }
+
+private:
+    std::uint64_t hash = 0xcbf29ce484222325ull;
+};
+
+// Replay Outcome
+struct ReplayResult
+{
+    bool completed = false; // Every ticker listed and every record acknowledged
+    std::uint64_t digest = 0; // Fingerprint of every ack and the final books, equal across runs of the same flow
+    std::size_t records = 0;
+    std::size_t rejected = 0; // Records acknowledged REJECTED (cancels of filled orders, market orders into empty books)
+    double seconds = 0; // First submission to last ack
+    double records_per_second = 0;
+};
+
+// Replay an Order Flow through an Exchange
+// Lists the flow's tickers, then submits every record asynchronously in file order, paced to _rate records per second
+// (0 submits as fast as the ingress rings take them). Engines trade in parallel, but each book sees its records
+// in file order, so acks and final books - and with them the digest - only change when engine behaviour does
+inline ReplayResult replay_flow(Exchange& _exchange, const OrderFlow& _flow, const double _rate = 0)
+{
+    ReplayResult result;
+    result.records = _flow.records.size();
+    std::vector<SymbolId> symbols;
+    for (const std::string& ticker : _flow.tickers)
+    {
+        symbols.push_back(_exchange.initialize_stock(ticker, _flow.ipo_price, _flow.ipo_qty, _flow.tick_size, _flow.lot_size));
+        if (!symbols.back())
+            return result; // Already listed or invalid
+    }
+
+    // Acks land by record index, each callback carries two words so std::function stores it inline
+    struct Pending
+    {
+        std::vector<OrderAck> acks;
+        std::vector<unsigned int> ids; // Order ID each record was given (cancels reuse their target's)
+        AckLatch latch;
+    } pending{std::vector<OrderAck>(_flow.records.size(), OrderAck{0, OrderStatus::REJECTED}), std::vector<unsigned int>(_flow.records.size(), 0), AckLatch(_flow.records.size())};
+
+    const std::int64_t start = now_ns();
+    const double ns_per_record = _rate > 0 ? 1e9 / _rate : 0;
+    for (std::size_t i = 0; i < _flow.records.size(); ++i)
+    {
+        // Pace against the schedule, not the previous send, so stalls are caught up
+        if (ns_per_record)
+            while (double(now_ns() - start) < double(i) * ns_per_record)
+                cpu_relax();
+
+        const FlowRecord& record = _flow.records[i];
+        Pending* state = &pending;
+        const std::uint32_t index = i;
+        AckCallback on_ack = [state, index](const OrderAck& _ack)
+        {
+            state->acks[index] = _ack;
+            state->latch.count_down();
+        };
+        const SymbolId symbol = symbols[record.ticker];
+        bool submitted = false;
+        switch (record.action)
+        {
+            case FlowAction::LIMIT:
+            case FlowAction::MARKET:
+                {
+                    const OrderType type = record.action == FlowAction::LIMIT ? OrderType::LIMIT : OrderType::MARKET;
+                    const double price = type == OrderType::LIMIT ? double(record.price) * _flow.tick_size : 0.0;
+                    pending.ids[i] = _exchange.submit_order(symbol, record.side, type, price, double(record.value) * _flow.lot_size, std::move(on_ack));
+                    submitted = pending.ids[i];
+                    break;
+                }
+
+            case FlowAction::CANCEL:
+                pending.ids[i] = record.value < i ? pending.ids[record.value] : 0;
+                submitted = pending.ids[i] && _exchange.submit_cancel(symbol, pending.ids[i], std::move(on_ack));
+                break;
+        }
+        if (!submitted)
+            pending.latch.count_down(); // Refused before reaching an engine, stays REJECTED
+    }
+    pending.latch.wait();
+    result.seconds = double(now_ns() - start) / 1e9;
+    result.records_per_second = result.seconds > 0 ? double(result.records) / result.seconds : 0;
+
+    // Fingerprint the acks, then each book
+    Fnv1a digest;
+    for (const OrderAck& ack : pending.acks)
+    {
+        digest.add(ack.id);
+        digest.add(ack.status);
+        result.rejected += ack.status == OrderStatus::REJECTED;
+    }
+    for (const SymbolId symbol : symbols)
+    {
+        const TopOfBook top = _exchange.get_top_of_book(symbol).value_or(TopOfBook{-1, -1, 0, 0, -1, 0, 0});
+        digest.add(top.bid);
+        digest.add(top.ask);
+        digest.add(top.last_price);
+        digest.add(top.last_qty);
+        for (const OrderSide side : {OrderSide::BID, OrderSide::ASK})
+            for (const auto& [price, qty] : _exchange.get_market_depth(symbol, side, static_cast<std::size_t>(-1)))
+            {
+                digest.add(std::llround(price / _flow.tick_size));
+                digest.add(std::llround(qty / _flow.lot_size));
+            }
+        for (const OrderStatus status : {OrderStatus::OPEN, OrderStatus::FILLED, OrderStatus::CANCELLED, OrderStatus::REJECTED})
+            digest.add(std::uint64_t(_exchange.get_order_count(symbol, status)));
+    }
+    result.digest = digest.value();
+    result.completed = true;
+    return result;
+}
@@ -0,0 +1,682 @@
+#pragma once
+#include "Exchange.cpp"
+#include <list>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <cerrno>
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <unistd.h>
+#endif
+
+// Wire Message Types
+enum class WireType : std::uint8_t
+{
+    NEW_ORDER,
+    CANCEL,
+    AMEND,
+    RESOLVE // Look up the ticker's Symbol ID at the gateway that serves it (answered in order_id)
+};
+
+// Wire Byte Order (little-endian): free on little-endian hosts, a byte swap on the others
+template <typename T>
+T wire_endian(const T _value)
+{
+    if constexpr (std::endian::native == std::endian::little || sizeof(T) == 1)
+        return _value;
+    else
+    {
+        auto bytes = std::bit_cast<std::array<std::byte, sizeof(T)>>(_value);
+        std::reverse(bytes.begin(), bytes.end());
+        return std::bit_cast<T>(bytes);
+    }
+}
+
+// Wire Request (fixed 48-byte little-endian record, decoded in place from the receive buffer)
+// Once a RESOLVE has answered a ticker's Symbol ID, requests carry it and the serving gateway skips the ticker hash,
+// only checking that the ID still names that ticker. The ticker still travels: it picks the shard, and IDs are only
+// unique within the gateway that answered the RESOLVE (a front gateway and its shard both hand out ID 1)
+struct WireRequest
+{
+    std::uint64_t tag; // Client correlation tag, echoed in the reply
+    double price; // Limit Price (ignored for market orders and cancels)
+    double qty; // Quantity (new quantity for amends)
+    std::uint32_t order_id; // Target Order ID for cancels and amends
+    WireType type;
+    std::uint8_t side; // OrderSide
+    std::uint8_t order_type; // OrderType
+    std::uint8_t reserved;
+    char ticker[12]; // NUL-padded routing key
+    std::uint32_t symbol; // Symbol ID from a RESOLVE (0 looks the ticker up)
+};
+static_assert(sizeof(WireRequest) == 48, "Wire layout");
+
+// Wire Reply (fixed 16-byte little-endian record, one per request)
+struct WireReply
+{
+    std::uint64_t tag; // Tag of the request it answers
+    std::uint32_t order_id; // Order ID the engine gave (the target's for cancels/amends, the Symbol ID for resolves), 0 if refused before any engine
+    std::uint8_t status; // OrderStatus
+    std::uint8_t reserved[3];
+};
+static_assert(sizeof(WireReply) == 16, "Wire layout");
+
+// Build Wire Requests (already in wire byte order, send as they are)
+inline WireRequest wire_resolve(const std::uint64_t _tag, const std::string& _ticker)
+{
+    WireRequest request{};
+    request.tag = wire_endian(_tag);
+    request.type = WireType::RESOLVE;
+    std::memcpy(request.ticker, _ticker.data(), std::min(_ticker.size(), sizeof(request.ticker)));
+    return request;
+}
+
+inline WireRequest wire_order(const std::uint64_t _tag, const std::string& _ticker, const OrderSide _side, const OrderType _type, const double _price, const double _qty, const SymbolId _symbol = 0)
+{
+    WireRequest request = wire_resolve(_tag, _ticker);
+    request.price = wire_endian(_price);
+    request.qty = wire_endian(_qty);
+    request.type = WireType::NEW_ORDER;
+    request.side = std::uint8_t(_side);
+    request.order_type = std::uint8_t(_type);
+    request.symbol = wire_endian(_symbol);
+    return request;
+}
+
+inline WireRequest wire_cancel(const std::uint64_t _tag, const std::string& _ticker, const unsigned int _id, const SymbolId _symbol = 0)
+{
+    WireRequest request = wire_resolve(_tag, _ticker);
+    request.order_id = wire_endian(std::uint32_t(_id));
+    request.type = WireType::CANCEL;
+    request.symbol = wire_endian(_symbol);
+    return request;
+}
+
+inline WireRequest wire_amend(const std::uint64_t _tag, const std::string& _ticker, const unsigned int _id, const double _price, const double _qty, const SymbolId _symbol = 0)
+{
+    WireRequest request = wire_cancel(_tag, _ticker, _id, _symbol);
+    request.type = WireType::AMEND;
+    request.price = wire_endian(_price);
+    request.qty = wire_endian(_qty);
+    return request;
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+
+// Listen on a TCP Port on every interface (0 picks a free one), returns the socket (-1 on failure) and the bound port
+inline int tcp_listen(const std::uint16_t _port, std::uint16_t& _bound)
+{
+    const int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0)
+        return -1;
+    const int on = 1;
+    ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_ANY);
+    address.sin_port = htons(_port);
+    socklen_t length = sizeof(address);
+    if (::bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) || ::listen(fd, SOMAXCONN) ||
+        ::getsockname(fd, reinterpret_cast<sockaddr*>(&address), &length))
+    {
+        ::close(fd);
+        return -1;
+    }
+    _bound = ntohs(address.sin_port);
+    return fd;
+}
+
+// Connect to a TCP Endpoint, returns the socket (-1 on failure)
+inline int tcp_connect(const std::string& _host, const std::uint16_t _port)
+{
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* found = nullptr;
+    if (::getaddrinfo(_host.c_str(), std::to_string(_port).c_str(), &hints, &found) || !found)
+        return -1;
+    int fd = ::socket(found->ai_family, found->ai_socktype, found->ai_protocol);
+    if (fd >= 0 && ::connect(fd, found->ai_addr, found->ai_addrlen))
+    {
+        ::close(fd);
+        fd = -1;
+    }
+    ::freeaddrinfo(found);
+    if (fd >= 0)
+    {
+        const int on = 1;
+        ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on)); // Latency over packet count
+    }
+    return fd;
+}
+
+// Write a whole Buffer, false if the peer went away
+inline bool write_all(const int _fd, const void* _data, std::size_t _size)
+{
+    const char* data = static_cast<const char*>(_data);
+    while (_size)
+    {
+        const ssize_t sent = ::send(_fd, data, _size, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR)
+            continue;
+        if (sent <= 0)
+            return false;
+        data += sent;
+        _size -= sent;
+    }
+    return true;
+}
+
+// Fixed-Record Socket Reader
+// Receives straight into a T-aligned buffer and hands out whole records in place, a torn tail waits for the next read
+template <typename T>
+class RecordReader
+{
+public:
+    RecordReader(const std::size_t _capacity = 4096)
+    : buffer(_capacity), filled(0)
+    {
+    }
+
+    // Block for the next batch of whole records, empty once the peer closes
+    std::span<const T> read(const int _fd)
+    {
+        // Move the torn tail of the previous batch to the front
+        const std::size_t consumed = filled / sizeof(T) * sizeof(T);
+        std::byte* bytes = reinterpret_cast<std::byte*>(buffer.data());
+        if (consumed)
+        {
+            std::memmove(bytes, bytes + consumed, filled - consumed);
+            filled -= consumed;
+        }
+        while (true)
+        {
+            const ssize_t received = ::recv(_fd, bytes + filled, buffer.size() * sizeof(T) - filled, 0);
+            if (received < 0 && errno == EINTR)
+                continue;
+            if (received <= 0)
+                return {};
+            filled += received;
+            if (filled >= sizeof(T))
+                return {buffer.data(), filled / sizeof(T)};
+        }
+    }
+
+private:
+    std::vector<T> buffer;
+    std::size_t filled; // Bytes received into buffer
+};
+
+// Gateway Shard Route
+struct ShardRoute
+{
+    std::string first_ticker; // Tickers from here up to the next route's first_ticker go to this shard
+    std::string host; // Shard gateway host (empty keeps the range on the local Exchange)
+    std::uint16_t port = 0;
+};
+
+// Gateway Configuration
+struct GatewayConfig
+{
+    std::uint16_t port = 0; // Listen port (0 picks a free one, see get_port)
+    std::vector<ShardRoute> routes; // Ticker ranges by first ticker, tickers below the first range trade locally
+};
+
+// Order Gateway
+// Serves an Exchange over TCP with the fixed-size wire records above. Each client connection gets a reader thread
+// that decodes requests in place from its receive buffer and submits them asynchronously, acks come back on the
+// engine threads and a writer thread flushes every queued reply in one send. Ticker ranges routed to another
+// gateway (another process or host) are forwarded over one pipelined link per shard and the replies routed back,
+// so a front gateway can shard tickers across engine processes past one box's core count
+class OrderGateway
+{
+    // One Client Connection
+    struct Session
+    {
+        int fd;
+        std::thread reader;
+        std::thread writer;
+        std::mutex lock; // Guards everything below
+        std::condition_variable wake;
+        std::vector<WireReply> outbox; // Replies waiting for the writer
+        std::size_t outstanding = 0; // Requests not yet answered
+        bool reading = true; // Reader still receiving
+        bool finished = false; // Writer flushed the last reply, safe to reap
+
+        // A request went out, its reply is owed
+        void begin()
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            ++outstanding;
+        }
+
+        // Queue a reply (wire byte order) for a request that began
+        void reply(const WireReply& _reply)
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            outbox.push_back(_reply);
+            --outstanding;
+            wake.notify_one();
+        }
+
+        // _tag is echoed as it came off the wire
+        void reply(const std::uint64_t _tag, const unsigned int _id, const OrderStatus _status)
+        {
+            reply(WireReply{_tag, wire_endian(std::uint32_t(_id)), std::uint8_t(_status), {}});
+        }
+    };
+
+    // Pipelined Link to a Shard Gateway
+    // Forwarded requests are retagged with a link sequence number, the reader maps replies back to their session
+    struct ShardLink
+    {
+        int fd = -1;
+        std::thread reader;
+        std::thread writer;
+        std::mutex lock; // Guards everything below
+        std::condition_variable wake;
+        std::vector<WireRequest> outbox; // Requests waiting for the writer
+        std::unordered_map<std::uint64_t, std::pair<Session*, std::uint64_t>> pending; // Link Tag -> Session, Client Tag
+        std::uint64_t next_tag = 0;
+        bool open = false;
+    };
+
+public:
+    OrderGateway(Exchange* _exchange, const GatewayConfig& _config = GatewayConfig())
+    : exchange(_exchange), config(_config), listen_fd(-1), port(0), running(false)
+    {
+        std::sort(config.routes.begin(), config.routes.end(), [](const ShardRoute& a, const ShardRoute& b) { return a.first_ticker < b.first_ticker; });
+    }
+
+    ~OrderGateway()
+    {
+        stop();
+    }
+
+    OrderGateway(const OrderGateway&) = delete;
+    OrderGateway& operator=(const OrderGateway&) = delete;
+
+    // Connect the shard links and start accepting clients, false if the port or a shard is unavailable
+    bool start()
+    {
+        if (running)
+            return true;
+        for (const ShardRoute& route : config.routes)
+        {
+            auto link = std::make_unique<ShardLink>();
+            if (!route.host.empty())
+            {
+                link->fd = tcp_connect(route.host, route.port);
+                if (link->fd < 0)
+                {
+                    std::cerr << "Gateway Error: Shard " << route.host << ":" << route.port << " unreachable\n";
+                    close_links();
+                    return false;
+                }
+                link->open = true;
+                ShardLink* raw = link.get();
+                link->reader = std::thread(&OrderGateway::link_reader, raw);
+                link->writer = std::thread(&OrderGateway::link_writer, raw);
+            }
+            links.push_back(std::move(link));
+        }
+        listen_fd = tcp_listen(config.port, port);
+        if (listen_fd < 0)
+        {
+            std::cerr << "Gateway Error: Cannot listen on port " << config.port << '\n';
+            close_links();
+            return false;
+        }
+        running = true;
+        listener = std::thread(&OrderGateway::accept_loop, this);
+        return true;
+    }
+
+    // Stop accepting, answer every request already received, then close every connection and shard link
+    void stop()
+    {
+        if (!running.exchange(false))
+            return;
+        ::shutdown(listen_fd, SHUT_RDWR); // Wakes accept()
+        listener.join();
+        ::close(listen_fd);
+
+        std::list<std::unique_ptr<Session>> closing;
+        {
+            std::lock_guard<std::mutex> guard(sessions_lock);
+            closing.swap(sessions);
+        }
+        for (auto& session : closing)
+            ::shutdown(session->fd, SHUT_RD); // Readers stop, writers drain what is owed
+        for (auto& session : closing)
+            reap(*session);
+        close_links();
+    }
+
+    // GET: Port the gateway listens on
+    std::uint16_t get_port() const { return port; }
+
+    // GET: Connected Clients
+    std::size_t get_session_count() const
+    {
+        std::lock_guard<std::mutex> guard(sessions_lock);
+        return sessions.size();
+    }
+
+private:
+    Exchange* exchange; // Local books (nullptr forwards everything or rejects)
+    GatewayConfig config;
+    std::vector<std::unique_ptr<ShardLink>> links; // One per route, closed links for local routes
+    int listen_fd;
+    std::uint16_t port;
+    std::atomic<bool> running;
+    std::thread listener;
+    mutable std::mutex sessions_lock;
+    std::list<std::unique_ptr<Session>> sessions;
+
+    // Accept Clients, reaping finished sessions as new ones arrive
+    void accept_loop()
+    {
+        while (running)
+        {
+            const int fd = ::accept(listen_fd, nullptr, nullptr);
+            if (fd < 0)
+            {
+                if (errno == EINTR || errno == ECONNABORTED)
+                    continue;
+                return; // Listening socket shut down
+            }
+            const int on = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+
+            std::lock_guard<std::mutex> guard(sessions_lock);
+            for (auto it = sessions.begin(); it != sessions.end();)
+            {
+                bool finished;
+                {
+                    std::lock_guard<std::mutex> session_guard((*it)->lock);
+                    finished = (*it)->finished;
+                }
+                if (!finished)
+                {
+                    ++it;
+                    continue;
+                }
+                reap(**it);
+                it = sessions.erase(it);
+            }
+            auto session = std::make_unique<Session>();
+            session->fd = fd;
+            Session* raw = session.get();
+            session->reader = std::thread(&OrderGateway::session_reader, this, raw);
+            session->writer = std::thread(&OrderGateway::session_writer, raw);
+            sessions.push_back(std::move(session));
+        }
+    }
+
+    // Join a Session's threads and close its socket
+    static void reap(Session& session)
+    {
+        session.reader.join();
+        session.writer.join();
+        ::close(session.fd);
+    }
+
+    // Decode Requests in place and route each one
+    void session_reader(Session* session)
+    {
+        RecordReader<WireRequest> reader;
+        for (auto batch = reader.read(session->fd); !batch.empty(); batch = reader.read(session->fd))
+            for (const WireRequest& request : batch)
+                route(*session, request);
+
+        std::lock_guard<std::mutex> guard(session->lock);
+        session->reading = false;
+        session->wake.notify_one();
+    }
+
+    // Flush queued Replies, one send per wakeup, until the client is gone and nothing is owed
+    static void session_writer(Session* session)
+    {
+        std::vector<WireReply> batch;
+        bool connected = true;
+        std::unique_lock<std::mutex> guard(session->lock);
+        while (true)
+        {
+            session->wake.wait(guard, [session]{ return !session->outbox.empty() || (!session->reading && !session->outstanding); });
+            if (session->outbox.empty())
+                break; // Nothing queued and nothing owed
+            batch.swap(session->outbox);
+            guard.unlock();
+            if (connected)
+                connected = write_all(session->fd, batch.data(), batch.size() * sizeof(WireReply)); // Drop replies to a vanished client
+            batch.clear();
+            guard.lock();
+        }
+        ::shutdown(session->fd, SHUT_WR); // Client sees end of stream after the last reply
+        session->finished = true;
+    }
+
+    // Index of the Route covering a Ticker, -1 if it trades locally
+    std::ptrdiff_t route_of(std::string_view _ticker) const
+    {
+        auto after = std::upper_bound(config.routes.begin(), config.routes.end(), _ticker, [](std::string_view ticker, const ShardRoute& route) { return ticker < route.first_ticker; });
+        if (after == config.routes.begin())
+            return -1;
+        const std::ptrdiff_t index = after - config.routes.begin() - 1;
+        return config.routes[index].host.empty() ? -1 : index;
+    }
+
+    // Route one Request to its shard or the local Exchange
+    void route(Session& session, const WireRequest& request)
+    {
+        const std::string_view ticker(request.ticker, strnlen(request.ticker, sizeof(request.ticker)));
+        session.begin();
+        const std::ptrdiff_t shard = route_of(ticker);
+        if (shard >= 0)
+            return forward(*links[shard], session, request);
+        // If nothing trades here, or the side/type is not one we know
+        if (!exchange || request.side > std::uint8_t(OrderSide::ASK) || request.order_type > std::uint8_t(OrderType::MARKET))
+            return session.reply(request.tag, 0, OrderStatus::REJECTED);
+
+        // Resolved requests name their book directly, only the others hash the ticker. A Symbol ID is only meaningful
+        // at the gateway that resolved it, so it must still name the ticker's book here (a stale or foreign ID is refused)
+        SymbolId symbol = wire_endian(request.symbol);
+        if (!symbol)
+            symbol = exchange->get_symbol_id(std::string(ticker));
+        else if (!exchange->is_listed_as(symbol, ticker))
+            return session.reply(request.tag, 0, OrderStatus::REJECTED);
+        if (request.type == WireType::RESOLVE)
+            return session.reply(request.tag, symbol, symbol ? OrderStatus::OPEN : OrderStatus::REJECTED);
+
+        // Two words, so std::function keeps the callback inline
+        Session* owner = &session;
+        const std::uint64_t tag = request.tag;
+        AckCallback on_ack = [owner, tag](const OrderAck& _ack) { owner->reply(tag, _ack.id, _ack.status); };
+        const double price = wire_endian(request.price);
+        const double qty = wire_endian(request.qty);
+        const unsigned int order_id = wire_endian(request.order_id);
+        bool submitted = false;
+        switch (request.type)
+        {
+            case WireType::NEW_ORDER:
+                submitted = exchange->submit_order(symbol, OrderSide(request.side), OrderType(request.order_type), price, qty, std::move(on_ack));
+                break;
+
+            case WireType::CANCEL:
+                submitted = exchange->submit_cancel(symbol, order_id, std::move(on_ack));
+                break;
+
+            case WireType::AMEND:
+                submitted = exchange->submit_amend(symbol, order_id, price, qty, std::move(on_ack));
+                break;
+
+            case WireType::RESOLVE:
+                break; // Answered above
+        }
+        if (!submitted)
+            session.reply(tag, 0, OrderStatus::REJECTED); // Refused before reaching an engine
+    }
+
+    // Forward a Request to a Shard Gateway under a link tag
+    static void forward(ShardLink& link, Session& session, const WireRequest& request)
+    {
+        std::unique_lock<std::mutex> guard(link.lock);
+        if (!link.open)
+        {
+            guard.unlock();
+            return session.reply(request.tag, 0, OrderStatus::REJECTED); // Shard gone
+        }
+        const std::uint64_t tag = ++link.next_tag;
+        link.pending.emplace(tag, std::make_pair(&session, request.tag));
+        link.outbox.push_back(request);
+        link.outbox.back().tag = wire_endian(tag);
+        link.wake.notify_one();
+    }
+
+    // Flush forwarded Requests, one send per wakeup
+    static void link_writer(ShardLink* link)
+    {
+        std::vector<WireRequest> batch;
+        std::unique_lock<std::mutex> guard(link->lock);
+        while (true)
+        {
+            link->wake.wait(guard, [link]{ return !link->outbox.empty() || !link->open; });
+            if (link->outbox.empty())
+                return; // Closed
+            batch.swap(link->outbox);
+            guard.unlock();
+            const bool sent = write_all(link->fd, batch.data(), batch.size() * sizeof(WireRequest));
+            batch.clear();
+            guard.lock();
+            if (!sent)
+                link->open = false; // The reader fails what is pending
+        }
+    }
+
+    // Route Shard Replies back to their sessions, failing whatever is pending once the shard goes away
+    static void link_reader(ShardLink* link)
+    {
+        RecordReader<WireReply> reader;
+        for (auto batch = reader.read(link->fd); !batch.empty(); batch = reader.read(link->fd))
+            for (const WireReply& reply : batch)
+            {
+                std::unique_lock<std::mutex> guard(link->lock);
+                auto found = link->pending.find(wire_endian(reply.tag));
+                if (found == link->pending.end())
+                    continue; // Not ours
+                const auto [session, tag] = found->second;
+                link->pending.erase(found);
+                guard.unlock();
+                session->reply(WireReply{tag, reply.order_id, reply.status, {}});
+            }
+
+        std::unordered_map<std::uint64_t, std::pair<Session*, std::uint64_t>> orphaned;
+        {
+            std::lock_guard<std::mutex> guard(link->lock);
+            link->open = false;
+            orphaned.swap(link->pending);
+            link->outbox.clear();
+            link->wake.notify_one();
+        }
+        for (const auto& [link_tag, owner] : orphaned)
+            owner.first->reply(owner.second, 0, OrderStatus::REJECTED);
+    }
+
+    // Close every Shard Link (sessions are gone, so nothing is pending)
+    void close_links()
+    {
+        for (auto& link : links)
+        {
+            if (link->fd < 0)
+                continue;
+            ::shutdown(link->fd, SHUT_RDWR);
+            link->reader.join();
+            link->writer.join();
+            ::close(link->fd);
+        }
+        links.clear();
+    }
+};
+
+// Gateway Client
+// Pipelines requests over one connection, replies arrive in completion order and carry the request tags
+class GatewayClient
+{
+public:
+    GatewayClient()
+    : fd(-1)
+    {
+    }
+
+    ~GatewayClient()
+    {
+        close();
+    }
+
+    GatewayClient(const GatewayClient&) = delete;
+    GatewayClient& operator=(const GatewayClient&) = delete;
+
+    // Connect to a Gateway, false if unreachable
+    bool connect(const std::string& _host, const std::uint16_t _port)
+    {
+        close();
+        fd = tcp_connect(_host, _port);
+        return fd >= 0;
+    }
+
+    void close()
+    {
+        if (fd >= 0)
+            ::close(fd);
+        fd = -1;
+    }
+
+    // Send Requests in one write, false if the gateway went away
+    bool send(std::span<const WireRequest> _requests)
+    {
+        return fd >= 0 && write_all(fd, _requests.data(), _requests.size() * sizeof(WireRequest));
+    }
+
+    bool send(const WireRequest& _request) { return send(std::span<const WireRequest>(&_request, 1)); }
+
+    // Block until at least one Reply arrives, appends up to what one read delivered (in host byte order). False once disconnected
+    bool receive(std::vector<WireReply>& _replies)
+    {
+        if (fd < 0)
+            return false;
+        auto batch = reader.read(fd);
+        for (const WireReply& reply : batch)
+            _replies.push_back(WireReply{wire_endian(reply.tag), wire_endian(reply.order_id), reply.status, {}});
+        return !batch.empty();
+    }
+
+    // Block until _count Replies arrived, false if the gateway went away first
+    bool receive(std::vector<WireReply>& _replies, const std::size_t _count)
+    {
+        const std::size_t target = _replies.size() + _count;
+        while (_replies.size() < target)
+            if (!receive(_replies))
+                return false;
+        return true;
+    }
+
+    // Close the sending side, the gateway answers what it has and then closes
+    void finish()
+    {
+        if (fd >= 0)
+            ::shutdown(fd, SHUT_WR);
+    }
+
+private:
+    int fd;
+    RecordReader<WireReply> reader;
+};
+
+#endif
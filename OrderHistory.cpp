@@ -0,0 +1,62 @@
+#pragma once
+#include "IdMap.cpp"
+#include <vector>
+#include <optional>
+#include <cstddef>
+
+// Retired Order History
+// Bounded ring of terminal (FILLED, CANCELLED, REJECTED) orders. The ring grows with the retirements up to its
+// capacity, then the oldest retirement is overwritten, so memory stays flat no matter how long the session runs
+// and a quiet symbol never pays for the full ring
+template <typename T>
+class OrderHistory
+{
+public:
+    OrderHistory(const std::size_t _capacity)
+    : limit(_capacity), next(0)
+    {
+    }
+
+    // Record a Retired Order, evicting the oldest when full
+    void push(const T& record)
+    {
+        if (!limit)
+            return; // History disabled
+        if (ring.size() < limit)
+            ring.emplace_back(); // Still growing
+        std::optional<T>& slot = ring[next];
+        if (slot)
+            index.erase(slot->id);
+        slot.emplace(record);
+        index.insert(record.id, next);
+        next = (next + 1) % limit;
+    }
+
+    // Find a Retired Order by ID (nullptr once evicted)
+    const T* find(const unsigned int _id) const
+    {
+        const std::size_t* pos = index.find(_id);
+        return pos ? &*ring[*pos] : nullptr;
+    }
+
+    // Visit Retired Orders, oldest first
+    template <typename Fn>
+    void for_each(Fn&& fn) const
+    {
+        for (std::size_t i = 0; i < ring.size(); ++i)
+        {
+            const std::optional<T>& slot = ring[(next + i) % ring.size()];
+            if (slot) fn(*slot);
+        }
+    }
+
+    std::size_t size() const { return index.size(); }
+
+    std::size_t capacity() const { return limit; }
+
+private:
+    std::vector<std::optional<T>> ring; // Retired Records (grows to limit)
+    IdMap<std::size_t> index; // Order ID -> Ring Slot (grows with the ring)
+    std::size_t limit; // Most Records kept
+    std::size_t next; // Next Slot to Overwrite
+};
@@ -1,107 +1,218 @@
 #pragma once
-#include <vector>
-#include <iostream>
+#include <set>
+#include <bit>
+#include <algorithm>
+#include <iterator>
+#include <cstdint>
 
-// Order Book
+// Price Level Index
+// Prices are integer ticks. Levels near the touch live in a dense bitmap window (O(1) push/find/pop/peek),
+// levels outside the window fall back to an ordered set (O(log n)).
+// MIN picks the side at compile time: the lowest price is best (asks) or the highest is (bids)
+template <bool MIN>
 class PriceHeap
 {
 public:
+    static constexpr int WINDOW_WORDS = 64; // Bitmap words (one summary bit each)
+    static constexpr std::int64_t WINDOW_TICKS = WINDOW_WORDS * 64; // Ticks covered by the window
+    static_assert(WINDOW_WORDS <= 64, "Summary word holds one bit per window word");
+
     PriceHeap()
-    : heap(0), min(true)
+    : base(0), window_count(0), summary(0), words{}
     {
     }
 
-    PriceHeap(const bool _min)
-    : heap(0), min(_min)
+    // Is price _a strictly better than _b for this side
+    static constexpr bool better(const std::int64_t _a, const std::int64_t _b)
     {
+        if constexpr (MIN)
+            return _a < _b;
+        else
+            return _a > _b;
     }
 
-    void push(const double data)
+    // Add Price Level
+    void push(const std::int64_t data)
     {
-        heap.push_back(data);
-        heapify_up(heap.size() - 1);
+        if (!window_count)
+            anchor(data); // Re-centre an empty window on the new level
+        if (in_window(data))
+            set_bit(data);
+        else
+            far.insert(data);
     }
 
-    void pop(const int index = 0)
+    // Remove Best Price Level
+    void pop()
     {
-            if (!heap.size()) 
-                return;
-            std::swap(heap[index], heap[heap.size() - 1]);
-            heap.pop_back();
-            heapify_down(index);
+        if (!size())
+            return;
+        pop(peek());
     }
 
-    double peek() const 
-    { 
-        if (!heap.size()) 
-            return -1;
-        return heap[0]; 
+    // Remove Price Level from anywhere in the Book
+    void pop(const std::int64_t data)
+    {
+        if (in_window(data))
+            clear_bit(data);
+        else
+            far.erase(data);
     }
 
-    double at(const int index) const
+    // Best Price Level
+    std::int64_t peek() const
     {
-        if (!heap.size()) 
+        if (!size())
             return -1;
-        return heap[index]; 
+        if constexpr (MIN)
+        {
+            if (!window_count)
+                return *far.begin();
+            const std::int64_t window_best = window_lowest();
+            return far.empty() ? window_best : std::min(window_best, *far.begin());
+        }
+        else
+        {
+            if (!window_count)
+                return *far.rbegin();
+            const std::int64_t window_best = window_highest();
+            return far.empty() ? window_best : std::max(window_best, *far.rbegin());
+        }
+    }
+
+    // Does Price Level Exist
+    bool find(const std::int64_t data) const
+    {
+        if (in_window(data))
+        {
+            const std::int64_t offset = data - base;
+            return words[offset >> 6] & (std::uint64_t(1) << (offset & 63));
+        }
+        return far.find(data) != far.end();
     }
 
-    int find(double data) const
+    // Next Price Level behind a price (worse for this side), -1 if none
+    // Lets callers walk the book best-first without copying or popping it
+    std::int64_t next(const std::int64_t data) const
     {
-        for (int i = 0; i < heap.size(); i++)
+        if constexpr (MIN)
         {
-            if (heap[i] == data) return i;
-        }  
-        return -1;
+            const std::int64_t window_next = window_above(data);
+            auto it = far.upper_bound(data);
+            if (it == far.end())
+                return window_next;
+            return window_next == -1 ? *it : std::min(window_next, *it);
+        }
+        else
+        {
+            const std::int64_t window_next = window_below(data);
+            auto it = far.lower_bound(data);
+            if (it == far.begin())
+                return window_next;
+            return std::max(window_next, *std::prev(it));
+        }
     }
 
-    int size() const { return heap.size(); }
+    int size() const { return window_count + far.size(); }
 
 private:
-    std::vector<double> heap;
-    const bool min;
+    std::int64_t base; // Lowest tick covered by the window
+    int window_count; // Levels held in the window
+    std::uint64_t summary; // Bit w set when words[w] is non-empty
+    std::uint64_t words[WINDOW_WORDS]; // One bit per tick in the window
+    std::set<std::int64_t> far; // Levels outside the window
 
-    // For Pushing from the End
-    void heapify_up(int index)
+    bool in_window(const std::int64_t data) const
     {
-        while (index > 0)
-        {
-            int parent = (index - 1) / 2;
-            if (min && heap[index] >= heap[parent]) break;
-            else if (!min && heap[index] <= heap[parent]) break;
-            std::swap(heap[index], heap[parent]);
-            index = parent;
-        }
+        return data >= base && data - base < WINDOW_TICKS;
+    }
+
+    void set_bit(const std::int64_t data)
+    {
+        const std::int64_t offset = data - base;
+        std::uint64_t& word = words[offset >> 6];
+        const std::uint64_t bit = std::uint64_t(1) << (offset & 63);
+        if (word & bit)
+            return;
+        word |= bit;
+        summary |= std::uint64_t(1) << (offset >> 6);
+        ++window_count;
     }
 
-    // For Popping from Front
-    void heapify_down(int index)
+    void clear_bit(const std::int64_t data)
     {
-        while (index < heap.size())
+        const std::int64_t offset = data - base;
+        std::uint64_t& word = words[offset >> 6];
+        const std::uint64_t bit = std::uint64_t(1) << (offset & 63);
+        if (!(word & bit))
+            return;
+        word &= ~bit;
+        if (!word)
+            summary &= ~(std::uint64_t(1) << (offset >> 6));
+        --window_count;
+    }
+
+    std::int64_t window_lowest() const
+    {
+        const int w = std::countr_zero(summary);
+        return base + w * 64 + std::countr_zero(words[w]);
+    }
+
+    std::int64_t window_highest() const
+    {
+        const int w = 63 - std::countl_zero(summary);
+        return base + w * 64 + 63 - std::countl_zero(words[w]);
+    }
+
+    // Lowest window level strictly above a price, -1 if none
+    std::int64_t window_above(const std::int64_t data) const
+    {
+        const std::int64_t start = std::max(data + 1, base);
+        if (!window_count || start - base >= WINDOW_TICKS)
+            return -1;
+        const std::int64_t offset = start - base;
+        const int w = offset >> 6;
+        const std::uint64_t word = words[w] & (~std::uint64_t(0) << (offset & 63));
+        if (word)
+            return base + w * 64 + std::countr_zero(word);
+        const std::uint64_t higher = w < 63 ? summary & (~std::uint64_t(0) << (w + 1)) : 0;
+        if (!higher)
+            return -1;
+        const int hw = std::countr_zero(higher);
+        return base + hw * 64 + std::countr_zero(words[hw]);
+    }
+
+    // Highest window level strictly below a price, -1 if none
+    std::int64_t window_below(const std::int64_t data) const
+    {
+        const std::int64_t end = std::min(data - 1, base + WINDOW_TICKS - 1);
+        if (!window_count || end < base)
+            return -1;
+        const std::int64_t offset = end - base;
+        const int w = offset >> 6;
+        const int b = offset & 63;
+        const std::uint64_t word = words[w] & (b == 63 ? ~std::uint64_t(0) : (std::uint64_t(1) << (b + 1)) - 1);
+        if (word)
+            return base + w * 64 + 63 - std::countl_zero(word);
+        const std::uint64_t lower = summary & ((std::uint64_t(1) << w) - 1);
+        if (!lower)
+            return -1;
+        const int lw = 63 - std::countl_zero(lower);
+        return base + lw * 64 + 63 - std::countl_zero(words[lw]);
+    }
+
+    // Move the (empty) window so it is centred on a price, pulling in any far levels it now covers
+    void anchor(const std::int64_t data)
+    {
+        base = data - WINDOW_TICKS / 2;
+        auto it = far.lower_bound(base);
+        while (it != far.end() && in_window(*it))
         {
-            int left_child = (index * 2) + 1 < heap.size() ? (index * 2) + 1 : index;
-            int right_child = (index * 2) + 2 < heap.size() ? (index * 2) + 2 : index;
-            int best_child = index;
-
-            if (left_child < heap.size()) 
-            {
-                if ((min && heap[left_child] < heap[best_child]) || (!min && heap[left_child] > heap[best_child])) 
-                {
-                    best_child = left_child;
-                }
-            }
-
-            if (right_child < heap.size()) 
-            {
-                if ((min && heap[right_child] < heap[best_child]) || (!min && heap[right_child] > heap[best_child])) 
-                {
-                    best_child = right_child;
-                }
-            }
-            
-            if (best_child == index) break;
-
-            std::swap(heap[index], heap[best_child]);
-            index = best_child;
+            set_bit(*it);
+            it = far.erase(it);
         }
     }
-};
\ No newline at end of file
+};
+
+using AskHeap = PriceHeap<true>; // Lowest ask is best
+using BidHeap = PriceHeap<false>; // Highest bid is best
@@ -0,0 +1,166 @@
+#pragma once
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <utility>
+
+// Lock-Free Multi-Producer / Single-Consumer Ring
+// Bounded queue in the style of Vyukov's array queue: every slot carries a sequence number, so producers
+// claim slots with one CAS and the consumer never contends with them. Capacity is rounded up to a power of two
+template <typename T>
+class MPSCRing
+{
+public:
+    MPSCRing(const std::size_t _capacity)
+    : head(0), tail(0)
+    {
+        std::size_t size = 2;
+        while (size < _capacity)
+            size <<= 1;
+        mask = size - 1;
+        slots = std::make_unique<Slot[]>(size);
+        for (std::size_t i = 0; i < size; ++i)
+            slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    MPSCRing(const MPSCRing&) = delete;
+    MPSCRing& operator=(const MPSCRing&) = delete;
+
+    // Enqueue (any thread), false if the ring is full
+    bool try_push(T&& item)
+    {
+        std::size_t pos = tail.load(std::memory_order_relaxed);
+        while (true)
+        {
+            Slot& slot = slots[pos & mask];
+            const std::size_t seq = slot.seq.load(std::memory_order_acquire);
+            const std::ptrdiff_t diff = std::ptrdiff_t(seq) - std::ptrdiff_t(pos);
+            if (!diff)
+            {
+                // seq_cst so a producer's later check of the consumer's sleep flag cannot be reordered before the claim
+                if (tail.compare_exchange_weak(pos, pos + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                {
+                    slot.item = std::move(item);
+                    slot.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+                return false; // Full
+            else
+                pos = tail.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Dequeue (consumer thread only), false if the ring is empty
+    bool try_pop(T& item)
+    {
+        const std::size_t pos = head.load(std::memory_order_relaxed);
+        Slot& slot = slots[pos & mask];
+        const std::size_t seq = slot.seq.load(std::memory_order_acquire);
+        if (seq != pos + 1)
+            return false; // Empty (or the next producer has not finished writing)
+        item = std::move(slot.item);
+        slot.seq.store(pos + mask + 1, std::memory_order_release);
+        head.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Is there an item ready for the consumer
+    bool empty() const
+    {
+        const std::size_t pos = head.load(std::memory_order_relaxed);
+        return slots[pos & mask].seq.load(std::memory_order_acquire) != pos + 1;
+    }
+
+    // Has any producer claimed a slot the consumer has not taken yet
+    // seq_cst pairs with the claim in try_push for sleep/wake handshakes. The consumer role may move between
+    // threads (handed over with acquire/release by the caller), so head is atomic but only ever relaxed
+    bool pending() const
+    {
+        return tail.load(std::memory_order_seq_cst) != head.load(std::memory_order_relaxed);
+    }
+
+    std::size_t capacity() const { return mask + 1; }
+
+private:
+    struct Slot
+    {
+        std::atomic<std::size_t> seq;
+        T item;
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    std::size_t mask;
+    alignas(64) std::atomic<std::size_t> head; // Consumer Cursor
+    alignas(64) std::atomic<std::size_t> tail; // Producer Cursor
+};
+
+// Lock-Free Single-Producer / Single-Consumer Ring
+// One writer and one reader, each owning a cursor, so neither side ever runs a CAS. Capacity is rounded up to a power of two
+template <typename T>
+class SPSCRing
+{
+public:
+    SPSCRing(const std::size_t _capacity)
+    : head(0), cached_tail(0), tail(0), cached_head(0)
+    {
+        std::size_t size = 2;
+        while (size < _capacity)
+            size <<= 1;
+        mask = size - 1;
+        slots = std::make_unique<T[]>(size);
+    }
+
+    SPSCRing(const SPSCRing&) = delete;
+    SPSCRing& operator=(const SPSCRing&) = delete;
+
+    // Enqueue (producer thread only), false if the ring is full
+    bool try_push(const T& item)
+    {
+        const std::size_t pos = tail.load(std::memory_order_relaxed);
+        if (pos - cached_head > mask)
+        {
+            cached_head = head.load(std::memory_order_acquire);
+            if (pos - cached_head > mask)
+                return false; // Full
+        }
+        slots[pos & mask] = item;
+        // seq_cst so a producer's later check of the consumer's sleep flag cannot be reordered before the publish
+        tail.store(pos + 1, std::memory_order_seq_cst);
+        return true;
+    }
+
+    // Dequeue (consumer thread only), false if the ring is empty
+    bool try_pop(T& item)
+    {
+        const std::size_t pos = head.load(std::memory_order_relaxed);
+        if (pos == cached_tail)
+        {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (pos == cached_tail)
+                return false; // Empty
+        }
+        item = slots[pos & mask];
+        head.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Is there an item ready for the consumer (consumer thread only)
+    // seq_cst pairs with the publish in try_push for sleep/wake handshakes
+    bool pending() const
+    {
+        return tail.load(std::memory_order_seq_cst) != head.load(std::memory_order_relaxed);
+    }
+
+    std::size_t capacity() const { return mask + 1; }
+
+private:
+    std::unique_ptr<T[]> slots;
+    std::size_t mask;
+    alignas(64) std::atomic<std::size_t> head; // Consumer Cursor
+    std::size_t cached_tail; // Consumer's last view of tail
+    alignas(64) std::atomic<std::size_t> tail; // Producer Cursor
+    std::size_t cached_head; // Producer's last view of head
+};
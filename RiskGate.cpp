@@ -0,0 +1,718 @@
+#pragma once
+#include "Exchange.cpp"
+#include <array>
+#include <unordered_map>
+
+// Pre-Trade Risk Stage
+// Orders for an account go through a lock-free ring to the risk thread, which checks them against the account's
+// limits and hands the ones that pass to their engine's ingress ring (one wakeup per engine per batch). Checks never
+// run on the matching thread or under order_lock. Positions, and the open orders amends are checked against, are kept
+// exact from the engines' execution reports, which carry the account back
+
+using AccountId = std::uint32_t; // 0 is never a valid account
+
+// Per-Account Limits (0 disables a limit)
+struct RiskLimits
+{
+    double max_order_qty = 0; // Largest single order
+    double max_order_notional = 0; // Largest single order value (price x qty, market orders at the opposing best or else the last trade)
+    double max_position = 0; // Largest net position in one stock if every open order on the side filled
+    double max_traded_notional = 0; // Gross value the account may trade over the session (reported fills plus the order)
+    double max_orders_per_second = 0; // Order entry rate (token bucket, bursts up to one second's worth)
+};
+
+// Risk Reject Reasons
+enum class RiskReject
+{
+    NONE,
+    UNKNOWN_ACCOUNT,
+    INVALID_ORDER,
+    UNKNOWN_STOCK,
+    ORDER_QTY,
+    ORDER_NOTIONAL,
+    POSITION,
+    TRADED_NOTIONAL,
+    RATE,
+    POSITIONS_FULL,
+    NO_PRICE,
+    UNKNOWN_ORDER,
+    ORDERS_FULL
+};
+
+inline const char* to_string(const RiskReject _reason)
+{
+    switch (_reason)
+    {
+        case RiskReject::NONE: return "NONE";
+        case RiskReject::UNKNOWN_ACCOUNT: return "UNKNOWN ACCOUNT";
+        case RiskReject::INVALID_ORDER: return "INVALID ORDER";
+        case RiskReject::UNKNOWN_STOCK: return "STOCK DOES NOT EXIST";
+        case RiskReject::ORDER_QTY: return "ORDER QUANTITY LIMIT";
+        case RiskReject::ORDER_NOTIONAL: return "ORDER NOTIONAL LIMIT";
+        case RiskReject::POSITION: return "POSITION LIMIT";
+        case RiskReject::TRADED_NOTIONAL: return "TRADED NOTIONAL LIMIT";
+        case RiskReject::RATE: return "ORDER RATE LIMIT";
+        case RiskReject::POSITIONS_FULL: return "POSITION TABLE FULL";
+        case RiskReject::NO_PRICE: return "NO PRICE TO VALUE MARKET ORDER";
+        case RiskReject::UNKNOWN_ORDER: return "ORDER NOT OPEN FOR ACCOUNT";
+        case RiskReject::ORDERS_FULL: return "OPEN ORDER TABLE FULL";
+    }
+    return "UNKNOWN";
+}
+
+// Risk Stage Configuration
+struct RiskConfig
+{
+    std::size_t capacity = 65536; // Commands the risk ring holds before submitters back off
+    std::size_t max_accounts = 1024; // Account IDs run 1 .. max_accounts - 1
+    std::size_t position_capacity = 65536; // Account x stock positions tracked (fixed table, never rehashes)
+    std::size_t order_capacity = 65536; // Open orders tracked for amends (fixed table, slots reused once an order is done)
+    WaitStrategy wait_strategy = WaitStrategy::BLOCKING; // How the risk thread idles between commands
+    int risk_core = -1; // CPU core to pin the risk thread to (-1 leaves it to the scheduler)
+    std::size_t reject_capacity = 1024; // Reject reports buffered for the reject consumer (the risk thread backs off while it is full)
+};
+
+// Account Position in one Stock
+struct RiskPosition
+{
+    double position; // Net filled quantity (bought - sold)
+    double open_buy; // Buy quantity accepted and not yet filled or cancelled
+    double open_sell; // Sell quantity accepted and not yet filled or cancelled
+};
+
+// Account Counters
+struct AccountRisk
+{
+    std::uint64_t accepted; // Orders and amends passed to the engines
+    std::uint64_t rejected; // Orders and amends refused by the risk stage
+    double traded_notional; // Gross value of reported fills
+};
+
+// Risk Reject Report (published by the risk thread for every refused order or amend)
+struct RiskRejectReport
+{
+    std::uint64_t seq; // Risk stage sequence number
+    std::time_t time; // Event Time
+    AccountId account;
+    SymbolId symbol;
+    unsigned int order_id; // Amended Order ID (0 for new orders)
+    RiskReject reason;
+};
+
+// Risk Ledger
+// Account state shared by the risk thread (checks and reservations) and every engine's report consumer (fills,
+// cancels, amends). All counters are atomics. Positions live in a fixed open-addressed table: slots are claimed
+// by the risk thread with one release store and never freed, so report consumers find them without a lock. Open
+// orders live in a second table the same way, except that the report consumer marks a slot DONE when its order
+// ends and the risk thread may claim it again (DONE never reverts to free, so lookups still stop at free slots)
+class RiskLedger
+{
+public:
+    struct Position
+    {
+        std::atomic<std::uint64_t> key{0}; // account << 32 | symbol, 0 while free
+        std::atomic<std::int64_t> position{0}; // Net filled lots
+        std::atomic<std::int64_t> open_buy{0}; // Lots reserved by accepted buys
+        std::atomic<std::int64_t> open_sell{0}; // Lots reserved by accepted sells
+    };
+
+    struct Order
+    {
+        std::atomic<std::uint64_t> key{0}; // symbol << 32 | order ID, 0 while never used, DONE once the order ended
+        std::atomic<std::int64_t> leaves{0}; // Lots still open
+        std::atomic<std::int64_t> price{0}; // Limit price in ticks
+        AccountId account = 0; // Risk thread only
+        OrderSide side = OrderSide::BID; // Risk thread only
+    };
+
+    struct alignas(64) Account
+    {
+        Seqlock<RiskLimits> limits; // Written under limits_lock, read by the risk thread
+        std::atomic<bool> active{false}; // Limits have been set
+        std::atomic<double> traded_notional{0};
+        std::atomic<std::uint64_t> accepted{0};
+        std::atomic<std::uint64_t> rejected{0};
+        double tokens = 0; // Rate bucket (risk thread only)
+        std::int64_t refilled_ns = 0;
+    };
+
+    RiskLedger(const std::size_t _max_accounts, const std::size_t _position_capacity, const std::size_t _order_capacity)
+    : accounts(std::max<std::size_t>(_max_accounts, 2)), mask(std::bit_ceil(std::max<std::size_t>(_position_capacity, 2)) - 1),
+      positions(std::make_unique<Position[]>(mask + 1)), order_mask(std::bit_ceil(std::max<std::size_t>(_order_capacity, 2)) - 1),
+      orders(std::make_unique<Order[]>(order_mask + 1))
+    {
+    }
+
+    // Account record, nullptr if the ID is out of range
+    Account* account(const AccountId _account)
+    {
+        return _account && _account < accounts.size() ? &accounts[_account] : nullptr;
+    }
+
+    const Account* account(const AccountId _account) const
+    {
+        return _account && _account < accounts.size() ? &accounts[_account] : nullptr;
+    }
+
+    // Position of an account in a stock (any thread), nullptr if it never traded there
+    Position* find(const AccountId _account, const SymbolId _symbol) const
+    {
+        const std::uint64_t key = key_of(_account, _symbol);
+        for (std::size_t i = 0, slot = hash(key, mask); i <= mask; ++i, slot = (slot + 1) & mask)
+        {
+            const std::uint64_t found = positions[slot].key.load(std::memory_order_acquire);
+            if (found == key)
+                return &positions[slot];
+            if (!found)
+                return nullptr;
+        }
+        return nullptr;
+    }
+
+    // Find or claim a Position (risk thread only), nullptr once the table is full
+    Position* claim(const AccountId _account, const SymbolId _symbol)
+    {
+        const std::uint64_t key = key_of(_account, _symbol);
+        for (std::size_t i = 0, slot = hash(key, mask); i <= mask; ++i, slot = (slot + 1) & mask)
+        {
+            const std::uint64_t found = positions[slot].key.load(std::memory_order_relaxed);
+            if (found == key)
+                return &positions[slot];
+            if (!found)
+            {
+                positions[slot].key.store(key, std::memory_order_release); // Counters are still zero
+                return &positions[slot];
+            }
+        }
+        return nullptr;
+    }
+
+    // Track an accepted Order until it ends (risk thread only, before the order is queued), false once every slot is open
+    bool track(const SymbolId _symbol, const unsigned int _id, const AccountId _account, const OrderSide _side, const std::int64_t _price, const std::int64_t _lots)
+    {
+        const std::uint64_t key = order_key(_symbol, _id);
+        for (std::size_t i = 0, slot = hash(key, order_mask); i <= order_mask; ++i, slot = (slot + 1) & order_mask)
+        {
+            Order& order = orders[slot];
+            const std::uint64_t found = order.key.load(std::memory_order_relaxed);
+            if (found && found != DONE)
+                continue;
+            order.leaves.store(_lots, std::memory_order_relaxed);
+            order.price.store(_price, std::memory_order_relaxed);
+            order.account = _account;
+            order.side = _side;
+            order.key.store(key, std::memory_order_release);
+            return true;
+        }
+        return false;
+    }
+
+    // Open Order of an Account (risk thread only), nullptr if it ended or another account entered it
+    // Its leaves and price can still move under a concurrent report
+    const Order* open_order(const SymbolId _symbol, const unsigned int _id, const AccountId _account) const
+    {
+        const Order* order = find_order(order_key(_symbol, _id));
+        return order && order->account == _account && order->leaves.load(std::memory_order_acquire) > 0 ? order : nullptr;
+    }
+
+    // Apply an Execution Report from a stock's engine (its report consumer thread)
+    // Fills move lots from open to the position, position first so a concurrent check over-counts rather than under
+    void apply(const SymbolId _symbol, const ExecutionReport& _report, const double _tick_value)
+    {
+        if (!_report.account)
+            return; // Entered around the risk stage
+        Position* slot = find(_report.account, _symbol);
+        if (!slot)
+            return;
+        const bool buy = _report.side == OrderSide::BID;
+        std::atomic<std::int64_t>& open = buy ? slot->open_buy : slot->open_sell;
+        Order* order = find_order(order_key(_symbol, _report.id));
+        switch (_report.type)
+        {
+            case ReportType::OPEN:
+                break; // Reserved when accepted
+
+            case ReportType::PARTIAL_FILL:
+            case ReportType::FILL:
+                // The order's leaves go first, so an amend check that sees the lots left open also sees them leave the order
+                if (order)
+                    settle(*order, _report.leaves);
+                slot->position.fetch_add(buy ? _report.qty : -_report.qty, std::memory_order_relaxed);
+                open.fetch_sub(_report.qty, std::memory_order_release);
+                if (Account* owner = account(_report.account))
+                    owner->traded_notional.fetch_add(double(_report.price) * double(_report.qty) * _tick_value, std::memory_order_relaxed);
+                break;
+
+            case ReportType::CANCEL:
+            case ReportType::REJECT:
+                if (order)
+                    settle(*order, 0);
+                open.fetch_sub(_report.qty, std::memory_order_release); // qty holds the lots left on the order
+                break;
+
+            case ReportType::AMEND:
+                if (order)
+                {
+                    order->price.store(_report.price, std::memory_order_relaxed);
+                    settle(*order, _report.leaves);
+                }
+                open.fetch_add(_report.leaves - _report.qty, std::memory_order_release); // New size less the old
+                break;
+        }
+    }
+
+    std::mutex limits_lock; // Serialises set_limits writers (each Seqlock has one writer at a time)
+
+private:
+    static constexpr std::uint64_t DONE = ~std::uint64_t(0); // Order slot whose order ended (no symbol has ID 2^32 - 1)
+
+    std::vector<Account> accounts;
+    std::size_t mask; // Position table size - 1 (power of two)
+    std::unique_ptr<Position[]> positions;
+    std::size_t order_mask; // Order table size - 1 (power of two)
+    std::unique_ptr<Order[]> orders;
+
+    static std::uint64_t key_of(const AccountId _account, const SymbolId _symbol)
+    {
+        return std::uint64_t(_account) << 32 | _symbol; // Never 0, symbol IDs start at 1
+    }
+
+    static std::uint64_t order_key(const SymbolId _symbol, const unsigned int _id)
+    {
+        return std::uint64_t(_symbol) << 32 | _id; // Never 0, symbol IDs start at 1
+    }
+
+    static std::size_t hash(const std::uint64_t _key, const std::size_t _mask)
+    {
+        std::uint64_t h = _key * 0x9E3779B97F4A7C15ull;
+        return std::size_t(h ^ (h >> 32)) & _mask;
+    }
+
+    // Order slot for a key (any thread), nullptr if it is not tracked
+    Order* find_order(const std::uint64_t _key) const
+    {
+        for (std::size_t i = 0, slot = hash(_key, order_mask); i <= order_mask; ++i, slot = (slot + 1) & order_mask)
+        {
+            const std::uint64_t found = orders[slot].key.load(std::memory_order_acquire);
+            if (found == _key)
+                return &orders[slot];
+            if (!found)
+                return nullptr;
+        }
+        return nullptr;
+    }
+
+    // Record the lots left on an Order (its report consumer), the slot is done once none are
+    static void settle(Order& _order, const std::int64_t _leaves)
+    {
+        _order.leaves.store(_leaves, std::memory_order_release);
+        if (_leaves <= 0)
+            _order.key.store(DONE, std::memory_order_release);
+    }
+};
+
+class RiskGate
+{
+public:
+    RiskGate(Exchange* _exchange, const RiskConfig& _config = RiskConfig(), bool _verbose = true)
+    : exchange(_exchange), Ledger(std::make_shared<RiskLedger>(_config.max_accounts, _config.position_capacity, _config.order_capacity)), Ingress(_config.capacity),
+      wait_strategy(_config.wait_strategy), risk_core(_config.risk_core), running(true), verbose(_verbose), RejectCounts{}, Rejects(_config.reject_capacity), reject_seq(0)
+    {
+        if (verbose)
+            Rejects.subscribe([](const RiskRejectReport& _report) { print_reject(_report); });
+        RiskThread = std::thread(&RiskGate::risk_stage, this);
+    }
+
+    // Drains every queued command before the risk thread exits, then stops feeding the ledger from engines still listed
+    ~RiskGate()
+    {
+        running = false;
+        Signal.notify_all();
+        if (RiskThread.joinable())
+            RiskThread.join();
+        for (auto& [symbol, watch] : watched)
+            if (auto engine = watch.engine.lock())
+                engine->unsubscribe_reports(watch.handle);
+    }
+
+    RiskGate(const RiskGate&) = delete;
+    RiskGate& operator=(const RiskGate&) = delete;
+
+    // Set (or replace) an Account's Limits, orders are refused until an account has them. False if the ID is out of range
+    bool set_limits(const AccountId _account, const RiskLimits& _limits)
+    {
+        RiskLedger::Account* account = Ledger->account(_account);
+        if (!account)
+        {
+            if (verbose)
+                std::cerr << "Risk Limits Error: Account " << _account << " Out Of Range" << '\n';
+            return false;
+        }
+        std::lock_guard<std::mutex> guard(Ledger->limits_lock);
+        account->limits.store(_limits);
+        account->active.store(true, std::memory_order_release);
+        return true;
+    }
+
+    // ASYNC: Submit an Order for an Account. The ack comes from the engine if the order reaches the book, or from the
+    // risk thread as {0, REJECTED} if it fails a check. False if the stock is not listed (the callback then never runs)
+    bool submit_order(const AccountId _account, const std::string& _ticker, OrderSide _side, OrderType _type, double _price, double _qty, AckCallback _on_ack = nullptr)
+    {
+        return submit_order(_account, exchange->get_symbol_id(_ticker), _side, _type, _price, _qty, std::move(_on_ack));
+    }
+
+    bool submit_order(const AccountId _account, SymbolId _symbol, OrderSide _side, OrderType _type, double _price, double _qty, AckCallback _on_ack = nullptr)
+    {
+        if (!_symbol)
+        {
+            if (verbose)
+                std::cerr << "Risk Submit Error: Stock Does Not Exist" << '\n';
+            return false;
+        }
+        enqueue(RiskCommand{RiskCommand::ORDER, _side, _type, _account, _symbol, 0, _price, _qty, std::move(_on_ack)});
+        return true;
+    }
+
+    // ASYNC: Submit an Amend for an Account's open order. It is checked like an order, except that the position limit
+    // counts only the lots it adds to (or takes off) the resting order. The ack comes from the engine, or from the risk
+    // thread as {order_id, REJECTED} if it fails a check. Amends sent straight to the Exchange are not checked
+    bool submit_amend(const AccountId _account, const std::string& _ticker, unsigned int order_id, double _price, double _qty, AckCallback _on_ack = nullptr)
+    {
+        return submit_amend(_account, exchange->get_symbol_id(_ticker), order_id, _price, _qty, std::move(_on_ack));
+    }
+
+    bool submit_amend(const AccountId _account, SymbolId _symbol, unsigned int order_id, double _price, double _qty, AckCallback _on_ack = nullptr)
+    {
+        if (!_symbol)
+        {
+            if (verbose)
+                std::cerr << "Risk Amend Error: Stock Does Not Exist" << '\n';
+            return false;
+        }
+        enqueue(RiskCommand{RiskCommand::AMEND, OrderSide::BID, OrderType::LIMIT, _account, _symbol, order_id, _price, _qty, std::move(_on_ack)});
+        return true;
+    }
+
+    // ASYNC: Submit a Cancel behind this gate's orders (it cannot overtake an order still being checked)
+    bool submit_cancel(const std::string& _ticker, unsigned int order_id, AckCallback _on_ack = nullptr)
+    {
+        return submit_cancel(exchange->get_symbol_id(_ticker), order_id, std::move(_on_ack));
+    }
+
+    bool submit_cancel(SymbolId _symbol, unsigned int order_id, AckCallback _on_ack = nullptr)
+    {
+        if (!_symbol)
+        {
+            if (verbose)
+                std::cerr << "Risk Cancel Error: Stock Does Not Exist" << '\n';
+            return false;
+        }
+        enqueue(RiskCommand{RiskCommand::CANCEL, OrderSide::BID, OrderType::LIMIT, 0, _symbol, order_id, 0, 0, std::move(_on_ack)});
+        return true;
+    }
+
+    // GET: Account Position in a Stock (nullopt if the account never traded it through this gate)
+    std::optional<RiskPosition> get_position(const AccountId _account, const std::string& _ticker) const
+    {
+        return get_position(_account, exchange->get_symbol_id(_ticker));
+    }
+
+    std::optional<RiskPosition> get_position(const AccountId _account, SymbolId _symbol) const
+    {
+        const RiskLedger::Position* slot = Ledger->find(_account, _symbol);
+        auto engine = slot ? exchange->get_engine(_symbol) : nullptr;
+        if (!engine)
+            return std::nullopt;
+        return RiskPosition{engine->to_qty(slot->position.load(std::memory_order_relaxed)), engine->to_qty(slot->open_buy.load(std::memory_order_relaxed)),
+            engine->to_qty(slot->open_sell.load(std::memory_order_relaxed))};
+    }
+
+    // GET: Account Counters (nullopt if the ID is out of range)
+    std::optional<AccountRisk> get_account(const AccountId _account) const
+    {
+        const RiskLedger::Account* account = Ledger->account(_account);
+        if (!account)
+            return std::nullopt;
+        return AccountRisk{account->accepted.load(std::memory_order_relaxed), account->rejected.load(std::memory_order_relaxed),
+            account->traded_notional.load(std::memory_order_relaxed)};
+    }
+
+    // GET: Orders refused for a reason since start-up
+    std::uint64_t get_reject_count(const RiskReject _reason) const
+    {
+        return RejectCounts[std::size_t(_reason)].load(std::memory_order_relaxed);
+    }
+
+    // Subscribe to Reject Reports (callback runs on the reject consumer thread, never the risk thread)
+    void subscribe_rejects(std::function<void(const RiskRejectReport&)> _subscriber)
+    {
+        Rejects.subscribe(std::move(_subscriber));
+    }
+
+    // Append Reject Reports to a binary file of RiskRejectReport records
+    bool record_rejects(const std::string& _path)
+    {
+        return Rejects.record_to(_path);
+    }
+
+    // GET: Commands queued for the risk thread and not yet checked
+    bool pending() const
+    {
+        return Ingress.pending();
+    }
+
+private:
+    static constexpr std::size_t RISK_BATCH = 256; // Commands checked per batch (one engine wakeup each)
+
+    struct RiskCommand
+    {
+        enum Type : std::uint8_t { ORDER, AMEND, CANCEL } type;
+        OrderSide side; // Amends take the side of the resting order
+        OrderType order_type;
+        AccountId account;
+        SymbolId symbol;
+        unsigned int order_id; // Target Order ID for amends and cancels
+        double price;
+        double qty;
+        AckCallback on_ack;
+    };
+
+    Exchange* exchange;
+    std::shared_ptr<RiskLedger> Ledger; // Shared with the report subscribers, unsubscribed when the gate goes
+    MPSCRing<RiskCommand> Ingress; // Submitters -> risk thread
+    WakeSignal Signal;
+    WaitStrategy wait_strategy;
+    int risk_core;
+    std::atomic<bool> running;
+    bool verbose;
+    std::array<std::atomic<std::uint64_t>, std::size_t(RiskReject::ORDERS_FULL) + 1> RejectCounts;
+    EventStream<RiskRejectReport> Rejects; // Refused orders, reported off the risk thread
+    std::uint64_t reject_seq;
+    std::thread RiskThread;
+
+    // Risk thread state
+    struct Watch
+    {
+        std::weak_ptr<OrderEngine> engine; // Not kept listed by the gate
+        std::uint64_t handle; // Ledger report subscription
+    };
+    std::unordered_map<SymbolId, Watch> watched; // Stocks whose reports feed the ledger
+    std::vector<std::pair<SymbolId, std::shared_ptr<OrderEngine>>> touched; // Engines handed commands in the current batch
+
+    void enqueue(RiskCommand&& cmd)
+    {
+        while (!Ingress.try_push(std::move(cmd)))
+        {
+            Signal.notify(); // Ring full, make sure the risk thread is checking
+            std::this_thread::yield();
+        }
+        Signal.notify();
+    }
+
+    // Risk Thread
+    void risk_stage()
+    {
+        // Dedicated Core
+        if (risk_core >= 0 && !pin_current_thread(risk_core) && verbose)
+            std::cerr << "[RISK] Failed to pin risk thread to core " << risk_core << '\n';
+
+        while (true)
+        {
+            if (drain())
+                continue; // Keep checking while there is flow
+
+            if (!running)
+                return; // Shut down once the queue is drained
+
+            // Idle until a submitter enqueues
+            switch (wait_strategy)
+            {
+                case WaitStrategy::BUSY_SPIN:
+                    cpu_relax();
+                    break;
+
+                case WaitStrategy::YIELD:
+                    std::this_thread::yield();
+                    break;
+
+                case WaitStrategy::BLOCKING:
+                    Signal.wait([this]{
+                            return !running || Ingress.pending();
+                    });
+                    break;
+            }
+        }
+    }
+
+    // Check a batch of Commands, then wake each engine that was handed one. False if the queue was empty
+    bool drain()
+    {
+        RiskCommand cmd;
+        std::size_t processed = 0;
+        for (; processed < RISK_BATCH && Ingress.try_pop(cmd); ++processed)
+        {
+            if (cmd.type != RiskCommand::CANCEL)
+                check_order(cmd);
+            else if (auto engine = route(cmd.symbol))
+                engine->enqueue_cancel(cmd.order_id, std::move(cmd.on_ack));
+            else if (cmd.on_ack)
+                cmd.on_ack(OrderAck{cmd.order_id, OrderStatus::REJECTED});
+        }
+        for (auto& [symbol, engine] : touched)
+            engine->flush();
+        touched.clear();
+        Rejects.notify(); // One consumer wakeup per batch
+        return processed;
+    }
+
+    // Engine for a Stock, remembered for this batch's wakeups (nullptr if not listed)
+    OrderEngine* route(const SymbolId _symbol)
+    {
+        for (auto& [symbol, engine] : touched)
+            if (symbol == _symbol)
+                return engine.get();
+        auto engine = exchange->get_engine(_symbol);
+        if (!engine)
+            return nullptr;
+        touched.emplace_back(_symbol, std::move(engine));
+        return touched.back().second.get();
+    }
+
+    // Check an Order (or Amend) against its Account, then reserve its lots and hand it to the engine
+    void check_order(RiskCommand& cmd)
+    {
+        RiskLedger::Account* account = Ledger->account(cmd.account);
+        RiskLedger::Position* position = nullptr;
+        OrderEngine* engine = nullptr;
+        OrderSide side = cmd.side;
+        std::int64_t lots = 0;
+        unsigned int id = 0;
+        const RiskReject reason = check(cmd, account, engine, position, side, lots, id);
+        if (reason != RiskReject::NONE)
+        {
+            if (account)
+                account->rejected.fetch_add(1, std::memory_order_relaxed);
+            RejectCounts[std::size_t(reason)].fetch_add(1, std::memory_order_relaxed);
+            if (Rejects.enabled())
+                Rejects.publish(RiskRejectReport{++reject_seq, std::time(nullptr), cmd.account, cmd.symbol, cmd.order_id, reason});
+            if (cmd.on_ack)
+                cmd.on_ack(OrderAck{cmd.order_id, OrderStatus::REJECTED});
+            return;
+        }
+
+        // Reports for this stock feed the ledger from here on (subscribed before its first order can fill)
+        if (!watched.contains(cmd.symbol))
+        {
+            const double tick_value = engine->get_tick_size() * engine->get_lot_size();
+            const std::uint64_t handle = engine->subscribe_reports([ledger = Ledger, symbol = cmd.symbol, tick_value](const ExecutionReport& _report)
+            {
+                ledger->apply(symbol, _report, tick_value);
+            });
+            const auto listed = std::find_if(touched.begin(), touched.end(), [&cmd](const auto& _touched) { return _touched.first == cmd.symbol; });
+            watched.emplace(cmd.symbol, Watch{listed->second, handle}); // route() put the engine there
+        }
+        account->accepted.fetch_add(1, std::memory_order_relaxed);
+        if (cmd.type == RiskCommand::AMEND)
+        {
+            // Nothing reserved here: the engine's AMEND report moves the open lots by the change in size
+            engine->enqueue_amend(cmd.order_id, cmd.price, cmd.qty, std::move(cmd.on_ack));
+            return;
+        }
+        (side == OrderSide::BID ? position->open_buy : position->open_sell).fetch_add(lots, std::memory_order_relaxed);
+        engine->enqueue_order(id, cmd.account, cmd.side, cmd.order_type, cmd.price, cmd.qty, std::move(cmd.on_ack));
+    }
+
+    // Pre-Trade Checks, cheapest first. Sets the engine, position, side and lots for an order that passes, and the ID
+    // a new order is tracked under
+    RiskReject check(const RiskCommand& cmd, RiskLedger::Account* account, OrderEngine*& engine, RiskLedger::Position*& position, OrderSide& side, std::int64_t& lots, unsigned int& id)
+    {
+        // If the account is unknown or has no limits
+        if (!account || !account->active.load(std::memory_order_acquire))
+            return RiskReject::UNKNOWN_ACCOUNT;
+        // If side or type is not valid, or price (limit) or qty less than or equal to 0
+        if ((cmd.side != OrderSide::BID && cmd.side != OrderSide::ASK) || (cmd.order_type != OrderType::LIMIT && cmd.order_type != OrderType::MARKET) ||
+            cmd.qty <= 0 || (cmd.order_type == OrderType::LIMIT && cmd.price <= 0))
+            return RiskReject::INVALID_ORDER;
+        engine = route(cmd.symbol);
+        if (!engine)
+            return RiskReject::UNKNOWN_STOCK;
+        lots = engine->to_lots(cmd.qty);
+        if (lots <= 0 || (cmd.order_type == OrderType::LIMIT && engine->to_ticks(cmd.price) <= 0))
+            return RiskReject::INVALID_ORDER; // Off the lot or tick grid
+
+        // An amend must target an open order of the same account, whose lots and value already count against it
+        const RiskLedger::Order* resting = cmd.type == RiskCommand::AMEND ? Ledger->open_order(cmd.symbol, cmd.order_id, cmd.account) : nullptr;
+        if (cmd.type == RiskCommand::AMEND && !resting)
+            return RiskReject::UNKNOWN_ORDER;
+        if (resting)
+            side = resting->side;
+
+        const RiskLimits limits = account->limits.load();
+        if (limits.max_order_qty > 0 && cmd.qty > limits.max_order_qty)
+            return RiskReject::ORDER_QTY;
+
+        // Market orders are valued at the opposing best they will trade against, or the last trade while that side is
+        // empty (it may fill before the order lands). With neither there is no value to hold the limits against
+        double price = cmd.price;
+        if (cmd.order_type == OrderType::MARKET)
+        {
+            const TopOfBook top = engine->get_top_of_book();
+            std::int64_t best = side == OrderSide::BID ? top.ask : top.bid;
+            if (best == -1)
+                best = top.last_price;
+            if (best == -1)
+                return RiskReject::NO_PRICE;
+            price = engine->to_price(best);
+        }
+        const double notional = price * cmd.qty;
+        if (limits.max_order_notional > 0 && notional > limits.max_order_notional)
+            return RiskReject::ORDER_NOTIONAL;
+        const double added_notional = resting ? std::max(0.0, notional - engine->to_price(resting->price.load(std::memory_order_relaxed)) *
+            engine->to_qty(resting->leaves.load(std::memory_order_relaxed))) : notional;
+
+        // Refill the rate bucket, taken only once the order passes
+        if (limits.max_orders_per_second > 0)
+        {
+            const std::int64_t now = now_ns();
+            account->tokens = std::min(std::max(limits.max_orders_per_second, 1.0), account->tokens + double(now - account->refilled_ns) * 1e-9 * limits.max_orders_per_second);
+            account->refilled_ns = now;
+            if (account->tokens < 1)
+                return RiskReject::RATE;
+        }
+
+        position = Ledger->claim(cmd.account, cmd.symbol);
+        if (!position)
+            return RiskReject::POSITIONS_FULL;
+        if (limits.max_position > 0)
+        {
+            // Open lots first (acquire), so a fill that already moved them to the position is seen there too, and the
+            // amended order's leaves after them, so those lots are not also taken off again
+            const std::int64_t open = (side == OrderSide::BID ? position->open_buy : position->open_sell).load(std::memory_order_acquire);
+            const std::int64_t net = position->position.load(std::memory_order_relaxed);
+            const std::int64_t added = resting ? lots - resting->leaves.load(std::memory_order_acquire) : lots; // Lots the order can newly trade
+            const std::int64_t worst = side == OrderSide::BID ? net + open + added : open + added - net;
+            if (added > 0 && engine->to_qty(worst) > limits.max_position) // An amend that shrinks the order only lowers the exposure
+                return RiskReject::POSITION;
+        }
+        if (limits.max_traded_notional > 0 && account->traded_notional.load(std::memory_order_relaxed) + added_notional > limits.max_traded_notional)
+            return RiskReject::TRADED_NOTIONAL;
+
+        // Track a new order under an ID taken now, so its slot exists before any report about it
+        if (cmd.type == RiskCommand::ORDER)
+        {
+            id = engine->reserve_order_id();
+            if (!Ledger->track(cmd.symbol, id, cmd.account, side, cmd.order_type == OrderType::LIMIT ? engine->to_ticks(cmd.price) : 0, lots))
+                return RiskReject::ORDERS_FULL;
+        }
+
+        if (limits.max_orders_per_second > 0)
+            account->tokens -= 1;
+        return RiskReject::NONE;
+    }
+
+    // Pretty-print a Reject Report (runs on the reject consumer thread)
+    static void print_reject(const RiskRejectReport& _report)
+    {
+        std::cerr << "Risk Reject: " << to_string(_report.reason) << " (Account " << _report.account << ", Symbol " << _report.symbol << ")" << '\n';
+    }
+};
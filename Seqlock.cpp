@@ -0,0 +1,77 @@
+#pragma once
+#include "WaitStrategy.cpp"
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <type_traits>
+
+// Single-Writer Sequence Lock
+// The writer bumps the sequence to odd, rewrites the value and bumps it back to even. Readers copy the
+// value and retry if the sequence was odd or moved, so they never block the writer or each other.
+// The value is held in relaxed atomic words (acquire/release on the edges) to stay race-free by the memory model
+template <typename T>
+class Seqlock
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Seqlock values are copied word by word");
+
+public:
+    Seqlock()
+    : seq(0)
+    {
+        for (auto& word : words)
+            word.store(0, std::memory_order_relaxed);
+    }
+
+    Seqlock(const T& _value)
+    : Seqlock()
+    {
+        store(_value);
+    }
+
+    Seqlock(const Seqlock&) = delete;
+    Seqlock& operator=(const Seqlock&) = delete;
+
+    // Publish a new Value (writer thread only)
+    void store(const T& _value)
+    {
+        std::uint64_t buffer[WORDS] = {};
+        std::memcpy(buffer, &_value, sizeof(T));
+
+        const std::uint64_t version = seq.load(std::memory_order_relaxed);
+        seq.store(version + 1, std::memory_order_relaxed); // Odd: write in progress
+        // Release stores keep the odd sequence ahead of the new words for any reader that observes them
+        for (std::size_t i = 0; i < WORDS; ++i)
+            words[i].store(buffer[i], std::memory_order_release);
+        seq.store(version + 2, std::memory_order_release); // Even: value stable
+    }
+
+    // Read a consistent copy of the Value (any thread)
+    T load() const
+    {
+        std::uint64_t buffer[WORDS];
+        while (true)
+        {
+            const std::uint64_t version = seq.load(std::memory_order_acquire);
+            if (version & 1)
+            {
+                cpu_relax(); // Writer mid-update
+                continue;
+            }
+            // Acquire loads keep the sequence re-check behind the copy
+            for (std::size_t i = 0; i < WORDS; ++i)
+                buffer[i] = words[i].load(std::memory_order_acquire);
+            if (seq.load(std::memory_order_relaxed) == version)
+                break;
+        }
+        T value;
+        std::memcpy(&value, buffer, sizeof(T));
+        return value;
+    }
+
+private:
+    static constexpr std::size_t WORDS = (sizeof(T) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+    alignas(64) std::atomic<std::uint64_t> seq; // Even when stable, odd while the writer is mid-update
+    std::atomic<std::uint64_t> words[WORDS];
+};
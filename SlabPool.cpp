@@ -0,0 +1,79 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+// Slab Allocator
+// Fixed-size records are carved out of slabs and recycled through a free list,
+// so acquiring and releasing a record never touches the global allocator once the pool is warm.
+// Slabs start at MIN_SLAB records and double up to SLAB_SIZE, so a pool that is barely used stays small.
+// Records never move, so pointers handed out stay valid until they are released
+template <typename T, std::size_t SLAB_SIZE = 4096, std::size_t MIN_SLAB = 64>
+class SlabPool
+{
+    static_assert(std::is_trivially_destructible_v<T>, "Pooled records are recycled without running destructors");
+    static_assert(MIN_SLAB > 0 && MIN_SLAB <= SLAB_SIZE, "Slab sizes");
+
+public:
+    // Nothing is allocated until the first acquire unless a capacity is asked for up front
+    SlabPool(const std::size_t _capacity = 0)
+    : total(0), live(0)
+    {
+        while (capacity() < _capacity)
+            grow();
+    }
+
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    // Construct a Record in a free Slot
+    template <typename... Args>
+    T* acquire(Args&&... args)
+    {
+        if (free_list.empty())
+            grow(); // Only allocates when every slot is in use
+        void* slot = free_list.back();
+        free_list.pop_back();
+        ++live;
+        return ::new (slot) T(std::forward<Args>(args)...);
+    }
+
+    // Return a Record's Slot to the Pool
+    void release(T* record)
+    {
+        if (!record)
+            return;
+        free_list.push_back(record); // Never reallocates, reserved to capacity in grow()
+        --live;
+    }
+
+    std::size_t size() const { return live; }
+
+    std::size_t capacity() const { return total; }
+
+private:
+    struct Slot
+    {
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> slabs; // Backing Slabs
+    std::vector<void*> free_list; // Free Slots (LIFO so recently used lines are reused first)
+    std::size_t total; // Slots across all slabs
+    std::size_t live; // Records in use
+
+    // Add a slab as large as the pool so far (doubling it), between MIN_SLAB and SLAB_SIZE slots
+    void grow()
+    {
+        const std::size_t size = std::min(SLAB_SIZE, std::max(MIN_SLAB, total));
+        slabs.emplace_back(new Slot[size]);
+        total += size;
+        free_list.reserve(total);
+        Slot* slab = slabs.back().get();
+        for (std::size_t i = size; i-- > 0;)
+            free_list.push_back(slab[i].storage);
+    }
+};
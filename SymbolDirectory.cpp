@@ -0,0 +1,387 @@
+#pragma once
+#include "WaitStrategy.cpp"
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+// Listing Handle (dense and never reused, 0 is never a valid listing)
+using SymbolId = std::uint32_t;
+
+// Concurrent Symbol Directory
+// Read-optimised map of ticker -> object for many routing threads and rare listing changes.
+// Every listing gets a dense integer ID that indexes a chunked slot array (IDs are never reused). A slot holds a raw
+// pointer, so a lookup by ID is one atomic load plus a pin on the calling thread's own reader slot: no lock, no
+// refcount, no cache line shared with other readers written. Delisting clears the pointer and waits for the
+// lookups that could have seen it to unpin before handing the object back (a grace period), so a pinned pointer
+// is never freed under its reader. Reader slots live in a push-only list that grows with the threads looking up at
+// the same time; a thread hands its slot back on exit for the next new thread to reuse. The ticker -> ID index is copy-on-write behind a shared_ptr; readers cache it
+// per thread and only take its guard to reload after a listing change.
+// Writers (list/delist) serialise among themselves and never block readers
+template <typename T>
+class SymbolDirectory
+{
+    // shared_ptr Cell behind a one-word spin guard (held for a pointer copy, portable where
+    // std::atomic<std::shared_ptr> is missing and visible to thread sanitizers)
+    template <typename V>
+    class SharedCell
+    {
+    public:
+        std::shared_ptr<V> load() const
+        {
+            lock();
+            std::shared_ptr<V> copy = value;
+            unlock();
+            return copy;
+        }
+
+        std::shared_ptr<V> exchange(std::shared_ptr<V> _value)
+        {
+            lock();
+            value.swap(_value);
+            unlock();
+            return _value; // Old value is released outside the guard
+        }
+
+    private:
+        mutable std::atomic<bool> guard{false};
+        std::shared_ptr<V> value;
+
+        void lock() const
+        {
+            while (guard.exchange(true, std::memory_order_acquire))
+                while (guard.load(std::memory_order_relaxed))
+                    cpu_relax();
+        }
+
+        void unlock() const { guard.store(false, std::memory_order_release); }
+    };
+
+    // Reader Slot, owned by one thread at a time. The sequence is odd while the owner holds a pin
+    struct alignas(64) Reader
+    {
+        std::atomic<std::uint64_t> seq{0};
+        std::uint32_t depth = 0; // Nested pins (owner only)
+        std::atomic<bool> owned{true}; // Claimed by a live thread
+        Reader* next = nullptr; // Older Reader (fixed once registered)
+    };
+
+    // Reader Registry, shared with the threads holding its slots so they can hand them back after the directory is gone
+    struct Registry
+    {
+        std::atomic<Reader*> head{nullptr}; // Newest Reader
+
+        ~Registry()
+        {
+            for (Reader* reader = head.load(std::memory_order_relaxed); reader;)
+                delete std::exchange(reader, reader->next);
+        }
+
+        // Reuse a handed back Reader, or register a new one (once per thread)
+        // seq_cst push so a delist that scans without it cleared its pointer before the new reader's first pin
+        Reader* claim()
+        {
+            for (Reader* reader = head.load(std::memory_order_seq_cst); reader; reader = reader->next)
+            {
+                bool owned = false;
+                if (!reader->owned.load(std::memory_order_relaxed) && reader->owned.compare_exchange_strong(owned, true, std::memory_order_acquire))
+                    return reader;
+            }
+            Reader* reader = new Reader;
+            reader->next = head.load(std::memory_order_relaxed);
+            while (!head.compare_exchange_weak(reader->next, reader, std::memory_order_seq_cst, std::memory_order_relaxed));
+            return reader;
+        }
+    };
+
+public:
+    using Index = std::unordered_map<std::string, SymbolId>;
+    static constexpr std::uint32_t CHUNK_SIZE = 1024; // Slots per chunk
+    static constexpr std::uint32_t MAX_CHUNKS = 1024; // Up to ~1M listings over the directory's life
+
+    // Pinned Lookup: the object is not handed back by a delist while this is held. Hold it for one call's worth
+    class Ref
+    {
+    public:
+        Ref() = default;
+        Ref(Ref&& _other) noexcept : value(std::exchange(_other.value, nullptr)), pin(std::exchange(_other.pin, nullptr)) {}
+        Ref& operator=(Ref&& _other) noexcept
+        {
+            if (this != &_other)
+            {
+                release();
+                value = std::exchange(_other.value, nullptr);
+                pin = std::exchange(_other.pin, nullptr);
+            }
+            return *this;
+        }
+        ~Ref() { release(); }
+
+        T* get() const { return value; }
+        T* operator->() const { return value; }
+        explicit operator bool() const { return value; }
+
+    private:
+        friend class SymbolDirectory;
+        Ref(T* _value, Reader* _pin) : value(_value), pin(_pin) {}
+
+        void release()
+        {
+            if (pin)
+                SymbolDirectory::unpin(*pin);
+            value = nullptr;
+            pin = nullptr;
+        }
+
+        T* value = nullptr;
+        Reader* pin = nullptr;
+    };
+
+    SymbolDirectory()
+    : version(0), registry(std::make_shared<Registry>()), next_id(1), instance(next_instance.fetch_add(1) + 1)
+    {
+        names.exchange(std::make_shared<const Index>());
+        for (auto& chunk : chunks)
+            chunk.store(nullptr, std::memory_order_relaxed);
+    }
+
+    ~SymbolDirectory()
+    {
+        for (auto& chunk : chunks)
+            delete[] chunk.load(std::memory_order_relaxed);
+    }
+
+    SymbolDirectory(const SymbolDirectory&) = delete;
+    SymbolDirectory& operator=(const SymbolDirectory&) = delete;
+
+    // Look up a Ticker (any thread), empty if not listed
+    Ref find(const std::string& _ticker) const
+    {
+        const Index& index = current();
+        auto found = index.find(_ticker);
+        return found == index.end() ? Ref() : find(found->second);
+    }
+
+    // Look up a Listing ID (any thread, wait-free), empty if unknown or delisted
+    Ref find(const SymbolId _id) const
+    {
+        Reader& reader = pin();
+        T* value = live(_id);
+        if (!value)
+        {
+            unpin(reader);
+            return Ref();
+        }
+        return Ref(value, &reader);
+    }
+
+    // Owning reference to a Listing (any thread), nullptr if unknown or delisted. Costs a refcount, keep it off hot paths
+    std::shared_ptr<T> share(const SymbolId _id) const
+    {
+        Reader& reader = pin();
+        // The owner is written before the pointer is published and only cleared after a grace period
+        std::shared_ptr<T> value = live(_id) ? slot_of(_id)->owner : nullptr;
+        unpin(reader);
+        return value;
+    }
+
+    // Listing ID of a Ticker (any thread), 0 if not listed
+    SymbolId id_of(const std::string& _ticker) const
+    {
+        const Index& index = current();
+        auto found = index.find(_ticker);
+        return found == index.end() ? 0 : found->second;
+    }
+
+    bool contains(const std::string& _ticker) const { return id_of(_ticker); }
+
+    // List a Ticker, returns its ID (0 if already listed or the directory is full)
+    SymbolId insert(const std::string& _ticker, std::shared_ptr<T> _value)
+    {
+        std::lock_guard<std::mutex> lock(write_lock);
+        std::shared_ptr<const Index> old_names = names.load();
+        if (old_names->count(_ticker))
+            return 0;
+        const SymbolId id = next_id;
+        const std::uint32_t chunk = id / CHUNK_SIZE;
+        if (chunk >= MAX_CHUNKS)
+            return 0;
+        if (!chunks[chunk].load(std::memory_order_relaxed))
+            chunks[chunk].store(new Slot[CHUNK_SIZE], std::memory_order_release);
+        ++next_id;
+
+        // Fill the slot before the name becomes visible
+        Slot& slot = chunks[chunk].load(std::memory_order_relaxed)[id % CHUNK_SIZE];
+        slot.owner = std::move(_value);
+        slot.live.store(slot.owner.get(), std::memory_order_release);
+        auto new_names = std::make_shared<Index>(*old_names);
+        new_names->emplace(_ticker, id);
+        publish(std::move(new_names));
+        return id;
+    }
+
+    // Delist a Ticker, returns what was listed (nullptr if nothing) once no lookup still holds it.
+    // Throws if the calling thread holds a pin itself (it would wait on itself)
+    std::shared_ptr<T> erase(const std::string& _ticker)
+    {
+        if (reader().depth)
+            throw std::runtime_error("Cannot Delist While Holding a Lookup");
+        std::lock_guard<std::mutex> lock(write_lock);
+        std::shared_ptr<const Index> old_names = names.load();
+        auto found = old_names->find(_ticker);
+        if (found == old_names->end())
+            return nullptr;
+        const SymbolId id = found->second;
+        auto new_names = std::make_shared<Index>(*old_names);
+        new_names->erase(_ticker);
+        publish(std::move(new_names));
+        Slot& slot = chunks[id / CHUNK_SIZE].load(std::memory_order_relaxed)[id % CHUNK_SIZE];
+        slot.live.store(nullptr, std::memory_order_seq_cst);
+        wait_for_readers();
+        return std::move(slot.owner);
+    }
+
+    // Visit every Listing in a consistent view (any thread)
+    template <typename Fn>
+    void for_each(Fn&& fn) const
+    {
+        const std::shared_ptr<const Index> index = names.load();
+        Reader& reader = pin();
+        for (const auto& [ticker, id] : *index)
+            if (live(id))
+                fn(ticker, slot_of(id)->owner);
+        unpin(reader);
+    }
+
+    std::size_t size() const { return names.load()->size(); }
+
+private:
+    // Listing Slot, written only by list/delist
+    struct Slot
+    {
+        std::atomic<T*> live{nullptr}; // Published object, nullptr until listed and after delisting
+        std::shared_ptr<T> owner; // Set when listed, handed back by the delist after its grace period
+    };
+
+    SharedCell<const Index> names; // Current ticker -> ID index
+    std::atomic<std::uint64_t> version; // Bumped after every index swap
+    std::atomic<Slot*> chunks[MAX_CHUNKS]; // Slot chunks, allocated on demand and never moved
+    std::shared_ptr<Registry> registry; // Per-thread pins
+    std::mutex write_lock; // Serialises writers
+    SymbolId next_id; // Next Listing ID (IDs start at 1, 0 is never valid)
+    const std::uint64_t instance; // Tells directories apart in the per-thread cache
+    static inline std::atomic<std::uint64_t> next_instance{0};
+
+    // Calling thread's Reader, claimed on its first lookup in this directory and handed back when the thread exits
+    Reader& reader() const
+    {
+        struct Claim
+        {
+            std::uint64_t instance;
+            std::weak_ptr<Registry> registry;
+            Reader* reader;
+        };
+        struct Claims
+        {
+            std::uint64_t instance = 0; // Last directory looked up in
+            Reader* reader = nullptr;
+            std::vector<Claim> held;
+
+            ~Claims()
+            {
+                for (const Claim& claim : held)
+                    if (auto registry = claim.registry.lock())
+                        claim.reader->owned.store(false, std::memory_order_release);
+            }
+        };
+        thread_local Claims claims;
+        if (claims.instance == instance)
+            return *claims.reader;
+
+        // Another directory, or the first lookup here. Drop claims on directories that are gone
+        std::erase_if(claims.held, [](const Claim& claim) { return claim.registry.expired(); });
+        auto found = std::find_if(claims.held.begin(), claims.held.end(), [this](const Claim& claim) { return claim.instance == instance; });
+        Reader* mine = found != claims.held.end() ? found->reader : claims.held.emplace_back(Claim{instance, registry, registry->claim()}).reader;
+        claims.instance = instance;
+        claims.reader = mine;
+        return *mine;
+    }
+
+    // Enter a lookup on the calling thread's slot. The seq_cst bump orders it before the pointer load,
+    // against the delist's pointer clear before its scan
+    Reader& pin() const
+    {
+        Reader& mine = reader();
+        if (!mine.depth++)
+            mine.seq.fetch_add(1, std::memory_order_seq_cst);
+        return mine;
+    }
+
+    static void unpin(Reader& _reader)
+    {
+        if (!--_reader.depth)
+            _reader.seq.fetch_add(1, std::memory_order_release);
+    }
+
+    // Wait until every pin taken before the pointer was cleared is gone (write_lock held)
+    void wait_for_readers() const
+    {
+        for (const Reader* reader = registry->head.load(std::memory_order_seq_cst); reader; reader = reader->next)
+        {
+            const std::uint64_t seq = reader->seq.load(std::memory_order_seq_cst);
+            if (seq & 1)
+                while (reader->seq.load(std::memory_order_acquire) == seq)
+                    cpu_relax();
+        }
+    }
+
+    // Published object under a Listing ID (pinned callers), nullptr if unknown or delisted
+    T* live(const SymbolId _id) const
+    {
+        const Slot* slot = slot_of(_id);
+        return slot ? slot->live.load(std::memory_order_seq_cst) : nullptr;
+    }
+
+    // Slot of a Listing ID, nullptr if its chunk was never allocated
+    const Slot* slot_of(const SymbolId _id) const
+    {
+        const std::uint32_t chunk = _id / CHUNK_SIZE;
+        if (!_id || chunk >= MAX_CHUNKS)
+            return nullptr;
+        const Slot* slots = chunks[chunk].load(std::memory_order_acquire);
+        return slots ? &slots[_id % CHUNK_SIZE] : nullptr;
+    }
+
+    // Swap in a new index (write_lock held)
+    void publish(std::shared_ptr<const Index> _names)
+    {
+        names.exchange(std::move(_names));
+        version.fetch_add(1, std::memory_order_release);
+    }
+
+    // Calling thread's cached index, reloaded when the directory changed
+    const Index& current() const
+    {
+        struct Cache
+        {
+            std::uint64_t instance = 0;
+            std::uint64_t version = 0;
+            std::shared_ptr<const Index> names;
+        };
+        thread_local Cache cache;
+        const std::uint64_t now = version.load(std::memory_order_acquire);
+        if (cache.instance != instance || cache.version != now || !cache.names)
+        {
+            cache.names = names.load();
+            cache.instance = instance;
+            cache.version = now;
+        }
+        return *cache.names;
+    }
+};
@@ -0,0 +1,89 @@
+#pragma once
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// Engine Idle Wait Strategies (as in the LMAX Disruptor)
+enum class WaitStrategy
+{
+    BLOCKING, // Sleep on a condition variable, lowest CPU use, highest wake-up latency
+    YIELD, // Spin with std::this_thread::yield, gives the core back to runnable threads
+    BUSY_SPIN // Spin with a pause hint, owns the core for the lowest latency
+};
+
+// Spin-Loop Hint (keeps a busy core from starving its hyperthread sibling)
+inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Pin the Calling Thread to a CPU Core, false if unsupported or refused
+inline bool pin_current_thread(const int _core)
+{
+#ifdef __linux__
+    if (_core < 0 || _core >= CPU_SETSIZE)
+        return false;
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(_core, &cpus);
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0;
+#else
+    (void)_core;
+    return false;
+#endif
+}
+
+// Sleep/Wake Handshake for a consumer thread
+// The sleeper raises its flag before re-checking for work, wakers publish work before checking the flag
+// (both seq_cst), so a waker either sees the flag and notifies or the sleeper sees the work. Idle wakers pay one load
+class WakeSignal
+{
+public:
+    WakeSignal()
+    : sleeping(false)
+    {
+    }
+
+    // Wake the sleeper if it is asleep
+    void notify()
+    {
+        if (!sleeping.load())
+            return;
+        std::lock_guard<std::mutex> guard(lock);
+        cv.notify_one();
+    }
+
+    // Wake the sleeper unconditionally (shutdown and other flag changes)
+    void notify_all()
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        cv.notify_all();
+    }
+
+    // Sleep until ready() holds
+    template <typename Ready>
+    void wait(Ready&& ready)
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        sleeping.store(true);
+        cv.wait(guard, ready);
+        sleeping.store(false);
+    }
+
+private:
+    std::mutex lock;
+    std::condition_variable cv;
+    std::atomic<bool> sleeping;
+};